@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+
+enum zmk_axis_constrain_axis {
+  ZMK_AXIS_CONSTRAIN_AXIS_NONE = 0,
+  ZMK_AXIS_CONSTRAIN_AXIS_X,
+  ZMK_AXIS_CONSTRAIN_AXIS_Y,
+};
+
+/** Parameters that can be changed at runtime. Defaults come from devicetree. */
+struct zmk_axis_constrain_params {
+  int  threshold;
+  bool sticky;
+  int  release_after_ms;
+};
+
+/**
+ * Read the active parameters of an axis constrain processor.
+ *
+ * @retval 0 on success
+ */
+int zmk_axis_constrain_get_params(const struct device              *dev,
+                                  struct zmk_axis_constrain_params *params);
+
+/**
+ * Replace the parameters of an axis constrain processor.
+ *
+ * The new values are published atomically: an event is processed either with
+ * the old or with the new set, never with a mix. The event path never waits
+ * for a writer. Must not be called from ISR context.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if threshold is not positive, above auto-threshold-max while
+ *         auto-threshold is enabled, release_after_ms is negative, or sticky is
+ *         set with release_after_ms of 0
+ */
+int zmk_axis_constrain_set_params(const struct device                    *dev,
+                                  const struct zmk_axis_constrain_params *params);
+
+/**
+ * Constrain a burst of events in place, e.g. all events of one sensor read.
+ *
+ * Equivalent to passing each event to the processor in order, but takes the
+ * instance lock once and restarts the sticky release timeout once, after the
+ * last event. All events see the same parameters. Events other than
+ * REL_X/REL_Y are left untouched; suppressed events get a value of 0. Per-event
+ * debug logs are not emitted for batches.
+ *
+ * With scale-multiplier or scale-divisor set, motion is scaled as well and
+ * the remainder of the division carried in remainder, which plays the role
+ * of the listener's remainder for track-remainders. It may be NULL.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if events is NULL and count is not 0
+ */
+int zmk_axis_constrain_handle_events(const struct device *dev, struct input_event *events,
+                                     size_t count, int16_t *remainder);
+
+int  zmk_axis_constrain_get_threshold(const struct device *dev);
+int  zmk_axis_constrain_set_threshold(const struct device *dev, int threshold);
+bool zmk_axis_constrain_get_sticky(const struct device *dev);
+int  zmk_axis_constrain_set_sticky(const struct device *dev, bool sticky);
+int  zmk_axis_constrain_get_release_after_ms(const struct device *dev);
+int  zmk_axis_constrain_set_release_after_ms(const struct device *dev, int release_after_ms);
+
+/** Snapshot of the live state of an axis constrain processor, for diagnostics. */
+struct zmk_axis_constrain_state {
+  enum zmk_axis_constrain_axis locked_axis;
+  int32_t                      accum_x;
+  int32_t                      accum_y;
+  int                          effective_threshold;
+  /** Threshold derived from the jitter estimate, 0 until it is warmed up */
+  int                          noise_threshold;
+  bool                         calibrating;
+  /** Events whose output differed from the reference model, see ..._SHADOW */
+  uint32_t                     shadow_divergences;
+};
+
+#define ZMK_AXIS_CONSTRAIN_LATENCY_BUCKETS 16
+
+/**
+ * Log2 histograms of lock acquisition latency, measured from the first motion
+ * after a reset to the event that locked an axis. Bucket 0 counts zero, bucket
+ * i counts values in [2^(i-1), 2^i) and the last bucket everything above.
+ */
+struct zmk_axis_constrain_latency_hist {
+  uint32_t events[ZMK_AXIS_CONSTRAIN_LATENCY_BUCKETS];
+  uint32_t ms[ZMK_AXIS_CONSTRAIN_LATENCY_BUCKETS];
+};
+
+/** Cycle counts measured with k_cycle_get_32() */
+struct zmk_axis_constrain_cycle_stat {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;
+};
+
+#define ZMK_AXIS_CONSTRAIN_BURST_BUCKETS 6
+
+/**
+ * Hot path timing. handle_event covers REL_X/REL_Y events only, lock_hold the
+ * time data->lock is held by any path. handle_events holds the cost per event
+ * of zmk_axis_constrain_handle_events() by burst length: bucket i covers
+ * bursts of [2^i, 2^(i+1)) events and the last bucket everything above.
+ */
+struct zmk_axis_constrain_profile {
+  struct zmk_axis_constrain_cycle_stat handle_event;
+  struct zmk_axis_constrain_cycle_stat handle_events[ZMK_AXIS_CONSTRAIN_BURST_BUCKETS];
+  struct zmk_axis_constrain_cycle_stat release_work;
+  struct zmk_axis_constrain_cycle_stat lock_hold;
+};
+
+/**
+ * Get an axis constrain processor by index, to enumerate all instances.
+ *
+ * @return the device, or NULL if index is past the last instance
+ */
+const struct device *zmk_axis_constrain_get_device(size_t index);
+
+/**
+ * RAM taken by the state of each instance, which depends on the build
+ * configuration (accumulator width, diagnostics), for size reports.
+ */
+size_t zmk_axis_constrain_get_instance_size(void);
+
+/**
+ * Take a consistent snapshot of the live state of an axis constrain processor.
+ *
+ * @retval 0 on success
+ */
+int zmk_axis_constrain_get_state(const struct device *dev, struct zmk_axis_constrain_state *state);
+
+/**
+ * Copy the lock latency histograms, optionally clearing them.
+ *
+ * Requires CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM.
+ *
+ * @retval 0 on success
+ */
+int zmk_axis_constrain_get_latency_hist(const struct device                    *dev,
+                                        struct zmk_axis_constrain_latency_hist *hist, bool reset);
+
+/**
+ * Copy the hot path timing, optionally clearing it.
+ *
+ * Requires CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING.
+ *
+ * @retval 0 on success
+ */
+int zmk_axis_constrain_get_profile(const struct device               *dev,
+                                   struct zmk_axis_constrain_profile *profile, bool reset);
+
+/**
+ * Start recording calibration strokes on an axis constrain processor.
+ *
+ * While calibrating, motion passes through unconstrained. After
+ * CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION_STROKES strokes,
+ * including at least one along each axis, the smallest threshold that locks
+ * every stroke to its principal axis is applied and persisted.
+ *
+ * @retval 0 on success
+ * @retval -EBUSY if calibration is already running
+ */
+int zmk_axis_constrain_calibrate_start(const struct device *dev);
+
+/**
+ * Abort a running calibration, keeping the current threshold.
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if no calibration is running
+ */
+int zmk_axis_constrain_calibrate_cancel(const struct device *dev);
+
+bool zmk_axis_constrain_is_calibrating(const struct device *dev);
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Binary trace of REL_X/REL_Y events, as written by "event_tap dump" and read
+ * by scripts/ac_replay.py.
+ *
+ * A trace starts with a header:
+ *   4 bytes  magic "ACTR"
+ *   1 byte   version, ZMK_AXIS_CONSTRAIN_TRACE_VERSION
+ *   1 byte   flags, 0
+ *
+ * followed by one record per event, each made of two unsigned LEB128 varints:
+ *   dt_ms    milliseconds since the previous event (0 for the first one)
+ *   code     (zigzag(value) << 1) | axis, axis 0 = REL_X, 1 = REL_Y
+ *
+ * Typical sensor reports need 2 bytes per event.
+ */
+
+#define ZMK_AXIS_CONSTRAIN_TRACE_MAGIC       "ACTR"
+#define ZMK_AXIS_CONSTRAIN_TRACE_VERSION     1
+#define ZMK_AXIS_CONSTRAIN_TRACE_HEADER_SIZE 6
+
+/* A varint of a 32-bit value takes at most 5 bytes */
+#define ZMK_AXIS_CONSTRAIN_TRACE_RECORD_MAX 10
+
+static inline size_t zmk_axis_constrain_trace_header(uint8_t *buf) {
+  buf[0] = 'A';
+  buf[1] = 'C';
+  buf[2] = 'T';
+  buf[3] = 'R';
+  buf[4] = ZMK_AXIS_CONSTRAIN_TRACE_VERSION;
+  buf[5] = 0;
+
+  return ZMK_AXIS_CONSTRAIN_TRACE_HEADER_SIZE;
+}
+
+static inline size_t zmk_axis_constrain_trace_varint(uint8_t *buf, uint32_t value) {
+  size_t len = 0;
+
+  while (value >= 0x80) {
+    buf[len++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buf[len++] = (uint8_t)value;
+
+  return len;
+}
+
+/**
+ * Encode one event into buf, which must hold ZMK_AXIS_CONSTRAIN_TRACE_RECORD_MAX
+ * bytes. value is limited to the int16_t range the event tap records.
+ *
+ * @return the number of bytes written
+ */
+static inline size_t zmk_axis_constrain_trace_record(uint8_t *buf, uint32_t dt_ms, bool is_y,
+                                                     int16_t value) {
+  uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value < 0 ? -1 : 0);
+  size_t   len    = zmk_axis_constrain_trace_varint(buf, dt_ms);
+
+  return len + zmk_axis_constrain_trace_varint(&buf[len], (zigzag << 1) | (is_y ? 1 : 0));
+}
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""Compute stroke quality metrics from an input and an output trace.
+
+The output trace is what ac_replay.py writes, or a recording from a second
+event tap placed after the processor:
+
+  ac_metrics.py before.trace after.trace
+  ac_metrics.py before.trace after.trace --strokes
+"""
+
+import argparse
+import sys
+
+from axis_constrain import metrics, trace
+
+
+def add_metrics_arguments(parser: argparse.ArgumentParser) -> None:
+    parser.add_argument("--stroke-gap-ms", type=int, default=metrics.DEFAULT_STROKE_GAP_MS,
+                        help="pause that separates strokes")
+    parser.add_argument("--min-travel", type=int, default=metrics.DEFAULT_MIN_TRAVEL,
+                        help="smallest net displacement counted as a stroke")
+
+
+def print_strokes(summary: metrics.Summary) -> None:
+    print("start_ms,axis,events,travel,latency_ms,latency_events,mislock,lost,straightness,flips")
+    for s in summary.strokes:
+        print(f"{s.start_ms},{'x' if s.principal_is_x else 'y'},{s.events},{s.travel},"
+              f"{'' if s.latency_ms is None else s.latency_ms},"
+              f"{'' if s.latency_events is None else s.latency_events},"
+              f"{int(s.mislock)},{s.lost},{s.straightness},{s.flips}")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input")
+    parser.add_argument("output")
+    parser.add_argument("--strokes", action="store_true", help="print every stroke as CSV")
+    add_metrics_arguments(parser)
+    args = parser.parse_args()
+
+    try:
+        summary = metrics.evaluate(trace.load(args.input), trace.load(args.output),
+                                   args.stroke_gap_ms, args.min_travel)
+    except (trace.TraceError, ValueError) as e:
+        sys.exit(f"error: {e}")
+
+    if args.strokes:
+        print_strokes(summary)
+    else:
+        print(summary.format())
+
+
+if __name__ == "__main__":
+    main()
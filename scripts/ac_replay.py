@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""Replay recorded traces through the axis constrain processor.
+
+Each input trace (binary, or captured "event_tap dump" output) is run through
+the firmware's handler, built for the host from tests/host and loaded by
+axis_constrain.host, with the trace timestamps as the clock. The output events
+are written as a trace of the same length, with suppressed events as 0.
+With --scale-multiplier/--scale-divisor the written output is scaled by the
+firmware's fused scale; metrics are computed from an unscaled run, in sensor
+counts.
+
+  ac_replay.py stroke.trace --threshold 8 --sticky --release-after-ms 150 -o out.trace
+"""
+
+import argparse
+import sys
+from pathlib import Path
+from typing import List, Tuple
+
+from ac_metrics import add_metrics_arguments
+from axis_constrain import host, metrics, trace
+
+
+def add_param_arguments(parser: argparse.ArgumentParser) -> None:
+    d = host.Params()
+    parser.add_argument("--threshold", type=int, default=d.threshold)
+    parser.add_argument("--sticky", action="store_true")
+    parser.add_argument("--release-after-ms", type=int, default=d.release_after_ms)
+    parser.add_argument("--auto-threshold", action="store_true")
+    parser.add_argument("--auto-threshold-k", type=int, default=d.auto_threshold_k)
+    parser.add_argument("--auto-threshold-max", type=int, default=d.auto_threshold_max)
+    parser.add_argument("--scale-multiplier", type=int, default=d.scale_multiplier)
+    parser.add_argument("--scale-divisor", type=int, default=d.scale_divisor)
+
+
+def params_from_args(args: argparse.Namespace) -> host.Params:
+    return host.Params(
+        threshold=args.threshold,
+        sticky=args.sticky,
+        release_after_ms=args.release_after_ms,
+        auto_threshold=args.auto_threshold,
+        auto_threshold_k=args.auto_threshold_k,
+        auto_threshold_max=args.auto_threshold_max,
+        scale_multiplier=args.scale_multiplier,
+        scale_divisor=args.scale_divisor,
+    )
+
+
+def replay(events: List[trace.Event],
+           params: host.Params) -> Tuple[List[trace.Event], List[int]]:
+    """Run events through a fresh processor; returns the output and the release times."""
+    host.run_pending()
+    host.reset_clock()
+    with host.Processor(params) as processor:
+        output = []
+        for e in events:
+            host.advance_to(e.t_ms)
+            output.append(trace.Event(e.t_ms, e.is_x, processor.handle_event(e.is_x, e.value)))
+        host.run_pending()
+        return output, processor.releases()
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("traces", nargs="+", type=Path)
+    parser.add_argument("-o", "--output", type=Path,
+                        help="output trace, or directory when replaying several traces")
+    parser.add_argument("--releases", action="store_true",
+                        help="list when the release work ran")
+    parser.add_argument("--metrics", action="store_true",
+                        help="print stroke metrics of each trace and of all of them")
+    add_param_arguments(parser)
+    add_metrics_arguments(parser)
+    args = parser.parse_args()
+
+    try:
+        params = params_from_args(args)
+        host.validate(params)
+    except (ValueError, host.HostError) as e:
+        sys.exit(f"error: {e}")
+
+    if args.output is not None and len(args.traces) > 1:
+        args.output.mkdir(parents=True, exist_ok=True)
+
+    total = metrics.Summary()
+    for path in args.traces:
+        try:
+            events = trace.load(path)
+        except trace.TraceError as e:
+            sys.exit(f"error: {path}: {e}")
+
+        try:
+            output, releases = replay(events, params.unscaled())
+        except ValueError as e:
+            sys.exit(f"error: {path}: {e}")
+        passed = sum(1 for e in output if e.value != 0)
+        print(f"{path}: {len(events)} events, {passed} passed, {len(events) - passed} suppressed, "
+              f"{len(releases)} releases")
+        if args.releases:
+            for t_ms in releases:
+                print(f"  {t_ms} ms: release_work")
+        if args.metrics:
+            summary = metrics.evaluate(events, output, args.stroke_gap_ms, args.min_travel)
+            total.strokes.extend(summary.strokes)
+            print(f"  {summary.format()}")
+
+        if args.output is None:
+            continue
+        dest = args.output / path.name if len(args.traces) > 1 else args.output
+        trace.save(dest, replay(events, params)[0] if params.scaled else output)
+
+    if args.metrics and len(args.traces) > 1:
+        print(f"total: {total.format()}")
+
+
+if __name__ == "__main__":
+    main()
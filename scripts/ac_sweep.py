@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""Grid-search processor settings over a corpus of recorded traces.
+
+Every combination of threshold, release timeout and mode is replayed over
+every trace in the corpus. The traces are split into shards, one worker
+process per shard; each worker returns summable totals per combination and
+the parent adds them up, so workers share nothing.
+
+Prints the settings on the Pareto front of mean lock latency, mislock rate
+and the fraction of strokes that never locked: no other setting is at least
+as good on all three and better on one. Latency and mislock rate only cover
+strokes that locked, so without the third objective a threshold too high to
+lock would score 0 on both and dominate every useful setting. Settings that
+lock no stroke at all are left out of the front.
+
+  ac_sweep.py traces/ --threshold 2:20 --release-after-ms 50,100,150,200
+"""
+
+import argparse
+import itertools
+import os
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Dict, List, Sequence, Tuple
+
+from ac_metrics import add_metrics_arguments
+from ac_replay import replay
+from axis_constrain import host, metrics, trace
+
+Setting = Tuple[bool, int, int]  # sticky, threshold, release_after_ms
+
+
+def int_list(text: str) -> List[int]:
+    """"5", "2,4,8" or an inclusive range "2:20" / "50:200:25"."""
+    values = []
+    for part in text.split(","):
+        if ":" in part:
+            bounds = [int(v) for v in part.split(":")]
+            start, stop, step = bounds[0], bounds[1], bounds[2] if len(bounds) > 2 else 1
+            values.extend(range(start, stop + 1, step))
+        else:
+            values.append(int(part))
+    return values
+
+
+def settings(thresholds: Sequence[int], releases: Sequence[int],
+             modes: Sequence[str]) -> List[Setting]:
+    out = []
+    for threshold in thresholds:
+        if "non-sticky" in modes:
+            # The release timeout only applies to sticky mode
+            out.append((False, threshold, 0))
+        if "sticky" in modes:
+            out.extend((True, threshold, release) for release in releases if release > 0)
+    return out
+
+
+def run_shard(paths: Sequence[Path], grid: Sequence[Setting], stroke_gap_ms: int,
+              min_travel: int) -> Dict[Setting, metrics.Totals]:
+    corpus = [trace.load(path) for path in paths]
+    results = {}
+    for setting in grid:
+        sticky, threshold, release = setting
+        params = host.Params(threshold=threshold, sticky=sticky, release_after_ms=release)
+        totals = metrics.Totals()
+        for events in corpus:
+            output, _ = replay(events, params)
+            summary = metrics.evaluate(events, output, stroke_gap_ms, min_travel)
+            totals = totals + metrics.Totals.of(summary)
+        results[setting] = totals
+    return results
+
+
+def objectives(totals: metrics.Totals) -> Tuple[float, float, float]:
+    return totals.mean_latency_ms, totals.mislock_rate, totals.unlocked_rate
+
+
+def pareto_front(results: Dict[Setting, metrics.Totals]) -> List[Setting]:
+    """Settings not dominated on (mean latency, mislock rate, unlocked rate).
+
+    Sorted by ascending objectives, a setting can only be dominated by one
+    before it; of settings with equal objectives the lowest threshold is kept.
+    """
+    ranked = sorted((s for s in results if results[s].locked),
+                    key=lambda s: (objectives(results[s]), s[1]))
+    front: List[Setting] = []
+    for setting in ranked:
+        score = objectives(results[setting])
+        if not any(all(a <= b for a, b in zip(objectives(results[kept]), score))
+                   for kept in front):
+            front.append(setting)
+    return front
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("corpus", nargs="+", type=Path,
+                        help="trace files or directories of them")
+    parser.add_argument("--threshold", type=int_list, default=int_list("1:20"))
+    parser.add_argument("--release-after-ms", type=int_list, default=int_list("50:300:50"))
+    parser.add_argument("--mode", choices=["sticky", "non-sticky"], action="append",
+                        help="limit the sweep to one mode (default: both)")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--all", action="store_true",
+                        help="print every setting, not only the Pareto front")
+    add_metrics_arguments(parser)
+    args = parser.parse_args()
+
+    paths = []
+    for entry in args.corpus:
+        paths.extend(sorted(p for p in entry.iterdir() if p.is_file())
+                     if entry.is_dir() else [entry])
+    if not paths:
+        sys.exit("error: no traces found")
+
+    grid = settings(args.threshold, args.release_after_ms, args.mode or ["sticky", "non-sticky"])
+    try:
+        for sticky, threshold, release in grid:
+            host.validate(host.Params(threshold=threshold, sticky=sticky,
+                                      release_after_ms=release))
+    except (ValueError, host.HostError) as e:
+        sys.exit(f"error: {e}")
+
+    jobs = max(1, min(args.jobs, len(paths)))
+    shards = [paths[i::jobs] for i in range(jobs)]
+    results = {setting: metrics.Totals() for setting in grid}
+
+    with ProcessPoolExecutor(max_workers=jobs) as pool:
+        futures = [pool.submit(run_shard, shard, grid, args.stroke_gap_ms, args.min_travel)
+                   for shard in shards]
+        for future in futures:
+            try:
+                shard_results = future.result()
+            except trace.TraceError as e:
+                sys.exit(f"error: {e}")
+            for setting, totals in shard_results.items():
+                results[setting] = results[setting] + totals
+
+    strokes = next(iter(results.values())).strokes if results else 0
+    print(f"# {len(paths)} traces, {strokes} strokes, {len(grid)} settings, {jobs} workers")
+    print("mode,threshold,release_after_ms,latency_ms,mislock,unlocked,lost,flips,straightness")
+    for setting in (sorted(results, key=lambda s: (not s[0], s[1], s[2])) if args.all
+                    else pareto_front(results)):
+        sticky, threshold, release = setting
+        t = results[setting]
+        print(f"{'sticky' if sticky else 'non-sticky'},{threshold},{release if sticky else ''},"
+              f"{t.mean_latency_ms:.1f},{t.mislock_rate:.4f},{t.unlocked_rate:.4f},"
+              f"{t.lost_ratio:.4f},{t.flips},{t.straightness}")
+
+
+if __name__ == "__main__":
+    main()
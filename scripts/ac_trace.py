@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""Convert event traces between the binary format, shell dumps and CSV.
+
+  ac_trace.py extract console.log -o stroke.trace
+  ac_trace.py csv stroke.trace
+  ac_trace.py encode stroke.csv -o stroke.trace
+"""
+
+import argparse
+import csv
+import sys
+from pathlib import Path
+
+from axis_constrain import trace
+
+
+def cmd_extract(args: argparse.Namespace) -> None:
+    text = Path(args.dump).read_text(errors="replace")
+    data = trace.parse_dump(text)
+    trace.decode(data)
+    Path(args.output).write_bytes(data)
+
+
+def cmd_csv(args: argparse.Namespace) -> None:
+    writer = csv.writer(sys.stdout)
+    writer.writerow(["t_ms", "axis", "value"])
+    for event in trace.load(args.trace):
+        writer.writerow([event.t_ms, "x" if event.is_x else "y", event.value])
+
+
+def cmd_encode(args: argparse.Namespace) -> None:
+    with open(args.csv, newline="") as f:
+        events = [
+            trace.Event(int(row["t_ms"]), row["axis"].lower() == "x", int(row["value"]))
+            for row in csv.DictReader(f)
+        ]
+    trace.save(args.output, events)
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("extract", help="extract a binary trace from event_tap dump output")
+    p.add_argument("dump")
+    p.add_argument("-o", "--output", required=True)
+    p.set_defaults(func=cmd_extract)
+
+    p = sub.add_parser("csv", help="print a trace as CSV")
+    p.add_argument("trace")
+    p.set_defaults(func=cmd_csv)
+
+    p = sub.add_parser("encode", help="encode t_ms,axis,value CSV as a binary trace")
+    p.add_argument("csv")
+    p.add_argument("-o", "--output", required=True)
+    p.set_defaults(func=cmd_encode)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except trace.TraceError as e:
+        sys.exit(f"error: {e}")
+
+
+if __name__ == "__main__":
+    main()
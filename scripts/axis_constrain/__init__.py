@@ -0,0 +1,3 @@
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""Host-side tools for the axis constrain input processor."""
@@ -0,0 +1,171 @@
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""ctypes binding of the host build of the processor (tests/host).
+
+The replay tools run events through the C handler of the firmware on stub
+kernel primitives, see tests/host/include/ac_host.h. Build it once with
+
+    cmake -S tests/host -B tests/host/build && cmake --build tests/host/build
+
+or point the AC_HOST_LIB environment variable at a libac_host built elsewhere.
+
+Time is the virtual clock of the library, shared by all processors of a
+process: advance_to() moves it to an event's timestamp and runs the sticky
+release work of every processor whose deadline it passes.
+"""
+
+import ctypes
+import dataclasses
+import errno
+import os
+from dataclasses import dataclass
+from pathlib import Path
+from typing import List, Optional
+
+BUILD_DIR = Path(__file__).resolve().parents[2] / "tests" / "host" / "build"
+
+
+class HostError(RuntimeError):
+    pass
+
+
+@dataclass(frozen=True)
+class Params:
+    """Devicetree properties of one instance."""
+
+    threshold: int = 5
+    sticky: bool = False
+    release_after_ms: int = 100
+    auto_threshold: bool = False
+    auto_threshold_k: int = 3
+    auto_threshold_max: int = 50
+    scale_multiplier: int = 1
+    scale_divisor: int = 1
+
+    @property
+    def scaled(self) -> bool:
+        return self.scale_multiplier != 1 or self.scale_divisor != 1
+
+    def unscaled(self) -> "Params":
+        return dataclasses.replace(self, scale_multiplier=1, scale_divisor=1)
+
+
+class _Params(ctypes.Structure):
+    """struct ac_host_params"""
+
+    _fields_ = [
+        ("threshold", ctypes.c_int32),
+        ("sticky", ctypes.c_bool),
+        ("release_after_ms", ctypes.c_int32),
+        ("auto_threshold", ctypes.c_bool),
+        ("auto_threshold_k", ctypes.c_int32),
+        ("auto_threshold_max", ctypes.c_int32),
+        ("scale_multiplier", ctypes.c_int32),
+        ("scale_divisor", ctypes.c_int32),
+    ]
+
+
+_lib: Optional[ctypes.CDLL] = None
+
+
+def _library() -> ctypes.CDLL:
+    global _lib
+    if _lib is not None:
+        return _lib
+
+    path = os.environ.get("AC_HOST_LIB")
+    if path is None:
+        found = sorted(BUILD_DIR.glob("libac_host.*"))
+        if not found:
+            raise HostError(f"no libac_host in {BUILD_DIR}: build it with "
+                            "'cmake -S tests/host -B tests/host/build && "
+                            "cmake --build tests/host/build' or set AC_HOST_LIB")
+        path = str(found[0])
+    try:
+        lib = ctypes.CDLL(path)
+    except OSError as e:
+        raise HostError(f"cannot load {path}: {e}") from e
+
+    handle = ctypes.c_void_p
+    lib.ac_host_create.argtypes = [ctypes.POINTER(_Params), ctypes.POINTER(handle)]
+    lib.ac_host_create.restype = ctypes.c_int
+    lib.ac_host_destroy.argtypes = [handle]
+    lib.ac_host_destroy.restype = None
+    lib.ac_host_event.argtypes = [handle, ctypes.c_bool, ctypes.c_int32]
+    lib.ac_host_event.restype = ctypes.c_int32
+    lib.ac_host_releases.argtypes = [handle, ctypes.POINTER(ctypes.c_uint32), ctypes.c_size_t]
+    lib.ac_host_releases.restype = ctypes.c_size_t
+    lib.ac_host_now_ms.argtypes = []
+    lib.ac_host_now_ms.restype = ctypes.c_uint32
+    lib.ac_host_advance_to.argtypes = [ctypes.c_uint32]
+    lib.ac_host_advance_to.restype = None
+    lib.ac_host_run_pending.argtypes = []
+    lib.ac_host_run_pending.restype = None
+    lib.ac_host_clock_reset.argtypes = []
+    lib.ac_host_clock_reset.restype = None
+
+    _lib = lib
+    return lib
+
+
+class Processor:
+    """One processor instance, created like a devicetree node with params."""
+
+    def __init__(self, params: Params):
+        lib = _library()
+        self._handle = ctypes.c_void_p()
+        ret = lib.ac_host_create(ctypes.byref(_Params(**dataclasses.asdict(params))),
+                                 ctypes.byref(self._handle))
+        if ret == -errno.EINVAL:
+            raise ValueError(f"the firmware would reject {params}")
+        if ret < 0:
+            raise HostError(f"ac_host_create failed ({ret})")
+
+    def handle_event(self, is_x: bool, value: int) -> int:
+        """Process one REL_X/REL_Y event at the current time and return the output value."""
+        return _library().ac_host_event(self._handle, is_x, value)
+
+    def releases(self) -> List[int]:
+        """Times at which the release work ran."""
+        lib = _library()
+        count = lib.ac_host_releases(self._handle, None, 0)
+        times = (ctypes.c_uint32 * count)()
+        lib.ac_host_releases(self._handle, times, count)
+        return list(times)
+
+    def close(self) -> None:
+        if self._handle:
+            _library().ac_host_destroy(self._handle)
+            self._handle = ctypes.c_void_p()
+
+    def __enter__(self) -> "Processor":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+
+def validate(params: Params) -> None:
+    """Raise ValueError if the firmware would reject params."""
+    Processor(params).close()
+
+
+def now_ms() -> int:
+    return _library().ac_host_now_ms()
+
+
+def advance_to(t_ms: int) -> None:
+    """Move time forward to t_ms, running work as it comes due."""
+    if t_ms < now_ms():
+        raise ValueError(f"time cannot go back from {now_ms()} to {t_ms} ms")
+    _library().ac_host_advance_to(t_ms)
+
+
+def run_pending() -> None:
+    """Advance until no work is pending, e.g. after the last event."""
+    _library().ac_host_run_pending()
+
+
+def reset_clock() -> None:
+    """Set the time back to 0; run_pending() first."""
+    _library().ac_host_clock_reset()
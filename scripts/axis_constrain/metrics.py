@@ -0,0 +1,230 @@
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""Stroke quality metrics over a pair of input and output streams.
+
+The output stream has one event per input event, as written by the replay or
+captured with a second event tap after the processor. Input is split into
+strokes at pauses of at least stroke_gap_ms; strokes whose net displacement
+is below min_travel counts are jitter and are skipped. The
+defaults follow the calibration Kconfig options.
+
+The principal axis of a stroke is the one with the larger net input
+displacement. Per stroke:
+
+  straightness   largest distance of the output path from the line along
+                 the principal axis, in counts
+  lost           principal-axis input travel that did not reach the output
+  latency        time and events from the stroke start to the first output
+  mislock        the first output moved along the minor axis
+  flips          changes of the output axis after the first output
+"""
+
+from dataclasses import dataclass, field
+from typing import List, Optional, Sequence
+
+from .trace import Event
+
+DEFAULT_STROKE_GAP_MS = 200
+DEFAULT_MIN_TRAVEL = 20
+
+
+@dataclass
+class StrokeMetrics:
+    start_ms: int
+    events: int
+    principal_is_x: bool
+    displacement: int
+    travel: int
+    straightness: int
+    lost: int
+    latency_ms: Optional[int]
+    latency_events: Optional[int]
+    mislock: bool
+    flips: int
+
+    @property
+    def locked(self) -> bool:
+        return self.latency_ms is not None
+
+
+@dataclass
+class Summary:
+    strokes: List[StrokeMetrics] = field(default_factory=list)
+
+    @property
+    def locked(self) -> List[StrokeMetrics]:
+        return [s for s in self.strokes if s.locked]
+
+    @property
+    def mislock_rate(self) -> float:
+        locked = self.locked
+        return sum(s.mislock for s in locked) / len(locked) if locked else 0.0
+
+    @property
+    def mean_latency_ms(self) -> float:
+        locked = self.locked
+        return sum(s.latency_ms for s in locked) / len(locked) if locked else 0.0
+
+    @property
+    def mean_latency_events(self) -> float:
+        locked = self.locked
+        return sum(s.latency_events for s in locked) / len(locked) if locked else 0.0
+
+    @property
+    def lost_ratio(self) -> float:
+        travel = sum(s.travel for s in self.strokes)
+        return sum(s.lost for s in self.strokes) / travel if travel else 0.0
+
+    @property
+    def max_straightness(self) -> int:
+        return max((s.straightness for s in self.strokes), default=0)
+
+    @property
+    def flips(self) -> int:
+        return sum(s.flips for s in self.strokes)
+
+    def format(self) -> str:
+        n = len(self.strokes)
+        return (f"{n} strokes, {n - len(self.locked)} never locked, "
+                f"mislock {self.mislock_rate:.1%}, "
+                f"latency {self.mean_latency_ms:.1f} ms / {self.mean_latency_events:.1f} events, "
+                f"lost {self.lost_ratio:.1%}, straightness {self.max_straightness}, "
+                f"flips {self.flips}")
+
+
+@dataclass(frozen=True)
+class Totals:
+    """Summable reduction of a Summary, for combining results across processes."""
+
+    strokes: int = 0
+    locked: int = 0
+    mislocks: int = 0
+    latency_ms: int = 0
+    latency_events: int = 0
+    travel: int = 0
+    lost: int = 0
+    flips: int = 0
+    straightness: int = 0
+
+    @classmethod
+    def of(cls, summary: Summary) -> "Totals":
+        locked = summary.locked
+        return cls(
+            strokes=len(summary.strokes),
+            locked=len(locked),
+            mislocks=sum(s.mislock for s in locked),
+            latency_ms=sum(s.latency_ms for s in locked),
+            latency_events=sum(s.latency_events for s in locked),
+            travel=sum(s.travel for s in summary.strokes),
+            lost=sum(s.lost for s in summary.strokes),
+            flips=summary.flips,
+            straightness=summary.max_straightness,
+        )
+
+    def __add__(self, other: "Totals") -> "Totals":
+        return Totals(
+            strokes=self.strokes + other.strokes,
+            locked=self.locked + other.locked,
+            mislocks=self.mislocks + other.mislocks,
+            latency_ms=self.latency_ms + other.latency_ms,
+            latency_events=self.latency_events + other.latency_events,
+            travel=self.travel + other.travel,
+            lost=self.lost + other.lost,
+            flips=self.flips + other.flips,
+            straightness=max(self.straightness, other.straightness),
+        )
+
+    @property
+    def mislock_rate(self) -> float:
+        return self.mislocks / self.locked if self.locked else 0.0
+
+    @property
+    def mean_latency_ms(self) -> float:
+        return self.latency_ms / self.locked if self.locked else 0.0
+
+    @property
+    def lost_ratio(self) -> float:
+        return self.lost / self.travel if self.travel else 0.0
+
+    @property
+    def unlocked_rate(self) -> float:
+        """Fraction of strokes that never produced output."""
+        return (self.strokes - self.locked) / self.strokes if self.strokes else 0.0
+
+
+def split_strokes(events: Sequence[Event],
+                  stroke_gap_ms: int = DEFAULT_STROKE_GAP_MS) -> List[range]:
+    """Index ranges of the strokes in events."""
+    strokes = []
+    start = 0
+    for i in range(1, len(events)):
+        if events[i].t_ms - events[i - 1].t_ms >= stroke_gap_ms:
+            strokes.append(range(start, i))
+            start = i
+    if events:
+        strokes.append(range(start, len(events)))
+    return strokes
+
+
+def stroke_metrics(inputs: Sequence[Event], outputs: Sequence[Event],
+                   indices: range) -> StrokeMetrics:
+    net_x = sum(inputs[i].value for i in indices if inputs[i].is_x)
+    net_y = sum(inputs[i].value for i in indices if not inputs[i].is_x)
+    principal_is_x = abs(net_x) >= abs(net_y)
+
+    start_ms = inputs[indices.start].t_ms
+    travel = 0
+    passed = 0
+    minor = 0
+    straightness = 0
+    first = None
+    last_axis = None
+    flips = 0
+
+    for n, i in enumerate(indices):
+        on_principal = inputs[i].is_x == principal_is_x
+        if on_principal:
+            travel += abs(inputs[i].value)
+
+        out = outputs[i]
+        if out.value == 0:
+            continue
+        if on_principal:
+            passed += abs(out.value)
+        else:
+            minor += out.value
+            straightness = max(straightness, abs(minor))
+
+        if first is None:
+            first = (out.t_ms - start_ms, n + 1, not on_principal)
+        elif out.is_x != last_axis:
+            flips += 1
+        last_axis = out.is_x
+
+    return StrokeMetrics(
+        start_ms=start_ms,
+        events=len(indices),
+        principal_is_x=principal_is_x,
+        displacement=max(abs(net_x), abs(net_y)),
+        travel=travel,
+        straightness=straightness,
+        lost=max(travel - passed, 0),
+        latency_ms=first[0] if first else None,
+        latency_events=first[1] if first else None,
+        mislock=first[2] if first else False,
+        flips=flips,
+    )
+
+
+def evaluate(inputs: Sequence[Event], outputs: Sequence[Event],
+             stroke_gap_ms: int = DEFAULT_STROKE_GAP_MS,
+             min_travel: int = DEFAULT_MIN_TRAVEL) -> Summary:
+    if len(inputs) != len(outputs):
+        raise ValueError(f"streams differ in length: {len(inputs)} in, {len(outputs)} out")
+
+    summary = Summary()
+    for indices in split_strokes(inputs, stroke_gap_ms):
+        stroke = stroke_metrics(inputs, outputs, indices)
+        if stroke.displacement >= min_travel:
+            summary.strokes.append(stroke)
+    return summary
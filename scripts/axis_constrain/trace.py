@@ -0,0 +1,115 @@
+# Copyright (c) 2026 matchey
+# SPDX-License-Identifier: BSD-3-Clause
+"""Reader and writer for the trace format of <zmk/axis_constrain_trace.h>."""
+
+import re
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Iterable, List
+
+MAGIC = b"ACTR"
+VERSION = 1
+HEADER_SIZE = 6
+
+
+class TraceError(ValueError):
+    pass
+
+
+@dataclass(frozen=True)
+class Event:
+    t_ms: int
+    is_x: bool
+    value: int
+
+
+def _zigzag(value: int) -> int:
+    return (value << 1) if value >= 0 else ((-value) << 1) - 1
+
+
+def _unzigzag(value: int) -> int:
+    return (value >> 1) if (value & 1) == 0 else -((value + 1) >> 1)
+
+
+def _varint(value: int) -> bytes:
+    out = bytearray()
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def encode(events: Iterable[Event]) -> bytes:
+    out = bytearray(MAGIC + bytes([VERSION, 0]))
+    last = None
+    for event in events:
+        dt = 0 if last is None else event.t_ms - last
+        if dt < 0:
+            raise TraceError(f"timestamps go backwards at {event.t_ms} ms")
+        out += _varint(dt)
+        out += _varint((_zigzag(event.value) << 1) | (0 if event.is_x else 1))
+        last = event.t_ms
+    return bytes(out)
+
+
+def decode(data: bytes) -> List[Event]:
+    if data[:4] != MAGIC:
+        raise TraceError("not a trace: bad magic")
+    if len(data) < HEADER_SIZE:
+        raise TraceError("truncated header")
+    if data[4] != VERSION:
+        raise TraceError(f"unsupported trace version {data[4]}")
+
+    events = []
+    fields = []
+    value = 0
+    shift = 0
+    t_ms = 0
+    for byte in data[HEADER_SIZE:]:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte & 0x80:
+            continue
+        fields.append(value)
+        value = 0
+        shift = 0
+        if len(fields) == 2:
+            dt, code = fields
+            t_ms += dt
+            events.append(Event(t_ms, (code & 1) == 0, _unzigzag(code >> 1)))
+            fields = []
+
+    if shift != 0 or fields:
+        raise TraceError("truncated record")
+    return events
+
+
+_HEX_LINE = re.compile(r"^[0-9a-f]+$")
+
+
+def parse_dump(text: str) -> bytes:
+    """Extract the first trace from captured "event_tap dump" output."""
+    data = bytearray()
+    for line in text.splitlines():
+        line = line.strip()
+        if not data and not line.startswith(MAGIC.hex()):
+            continue
+        if not (_HEX_LINE.match(line) and len(line) % 2 == 0):
+            break
+        data += bytes.fromhex(line)
+    if not data:
+        raise TraceError("no trace found in dump")
+    return bytes(data)
+
+
+def load(path: Path) -> List[Event]:
+    """Load a binary trace, or the shell output of "event_tap dump"."""
+    data = Path(path).read_bytes()
+    if data[:4] != MAGIC:
+        data = parse_dump(data.decode("utf-8", errors="replace"))
+    return decode(data)
+
+
+def save(path: Path, events: Iterable[Event]) -> None:
+    Path(path).write_bytes(encode(events))
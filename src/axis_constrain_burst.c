@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define DT_DRV_COMPAT zmk_axis_constrain_burst
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <zmk/axis_constrain.h>
+
+LOG_MODULE_DECLARE(axis_constrain, CONFIG_ZMK_LOG_LEVEL);
+
+struct burst_config {
+  const struct device *processor;
+  struct input_event  *events;
+  size_t               capacity;
+};
+
+/* Only touched from the callback of the source device, which is never reentered */
+struct burst_data {
+  size_t   count;
+  uint32_t dropped;
+  /* Carried between bursts for the fused scale of the processor */
+  int16_t  remainder;
+};
+
+static void burst_flush(const struct device *dev) {
+  const struct burst_config *config  = dev->config;
+  struct burst_data         *data    = dev->data;
+  uint32_t                   dropped = 0;
+
+  zmk_axis_constrain_handle_events(config->processor, config->events, data->count,
+                                   &data->remainder);
+
+  for (size_t i = 0; i < data->count; i++) {
+    const struct input_event *event = &config->events[i];
+
+    /* Suppressed motion is not reported again, unless it completes the report */
+    if (event->type == INPUT_EV_REL && event->value == 0 && !event->sync) {
+      continue;
+    }
+
+    /* Never block: in thread mode this runs on the input thread that drains the queue */
+    if (input_report(dev, event->type, event->code, event->value, event->sync, K_NO_WAIT) < 0) {
+      dropped++;
+    }
+  }
+
+  data->count = 0;
+
+  if (dropped > 0) {
+    data->dropped += dropped;
+    LOG_WRN("%s: input queue full, dropped %u of the burst (%u total)", dev->name, dropped,
+            data->dropped);
+  }
+}
+
+static void burst_handle(const struct device *dev, const struct input_event *event) {
+  const struct burst_config *config = dev->config;
+  struct burst_data         *data   = dev->data;
+
+  config->events[data->count++] = *event;
+
+  if (event->sync || data->count == config->capacity) {
+    burst_flush(dev);
+  }
+}
+
+#define BURST_INST(n)                                                                         \
+  BUILD_ASSERT(DT_INST_PROP(n, burst_size) > 0, "burst-size must be greater than 0");         \
+  BUILD_ASSERT(DT_NODE_HAS_COMPAT(DT_INST_PHANDLE(n, input_processor),                        \
+                                  zmk_input_processor_axis_constrain),                        \
+               "input-processor must be an axis constrain processor");                        \
+                                                                                              \
+  static struct input_event axis_constrain_burst_events_##n[DT_INST_PROP(n, burst_size)];     \
+                                                                                              \
+  static struct burst_data axis_constrain_burst_data_##n;                                     \
+                                                                                              \
+  static const struct burst_config axis_constrain_burst_config_##n = {                        \
+      .processor = DEVICE_DT_GET(DT_INST_PHANDLE(n, input_processor)),                        \
+      .events    = axis_constrain_burst_events_##n,                                           \
+      .capacity  = DT_INST_PROP(n, burst_size),                                               \
+  };                                                                                          \
+                                                                                              \
+  DEVICE_DT_INST_DEFINE(n, NULL, NULL, &axis_constrain_burst_data_##n,                        \
+                        &axis_constrain_burst_config_##n, POST_KERNEL,                        \
+                        CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, NULL);                           \
+                                                                                              \
+  static void axis_constrain_burst_callback_##n(struct input_event *event, void *user_data) { \
+    burst_handle(DEVICE_DT_INST_GET(n), event);                                               \
+  }                                                                                           \
+                                                                                              \
+  INPUT_CALLBACK_DEFINE(DEVICE_DT_GET(DT_INST_PHANDLE(n, device)),                            \
+                        axis_constrain_burst_callback_##n, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(BURST_INST)
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/shell/shell.h>
+
+#include <zmk/axis_constrain.h>
+
+static const char *axis_name(enum zmk_axis_constrain_axis axis) {
+  switch (axis) {
+    case ZMK_AXIS_CONSTRAIN_AXIS_X:
+      return "X";
+    case ZMK_AXIS_CONSTRAIN_AXIS_Y:
+      return "Y";
+    default:
+      return "NONE";
+  }
+}
+
+static const struct device *find_device(const struct shell *sh, const char *name) {
+  const struct device *dev;
+
+  for (size_t i = 0; (dev = zmk_axis_constrain_get_device(i)) != NULL; i++) {
+    if (strcmp(dev->name, name) == 0) {
+      return dev;
+    }
+  }
+
+  shell_error(sh, "No axis constrain instance named %s", name);
+  return NULL;
+}
+
+static void print_device(const struct shell *sh, const struct device *dev) {
+  struct zmk_axis_constrain_params params;
+  struct zmk_axis_constrain_state  state;
+
+  zmk_axis_constrain_get_params(dev, &params);
+  zmk_axis_constrain_get_state(dev, &state);
+
+  shell_print(sh, "%s:", dev->name);
+  shell_print(sh, "  threshold=%d sticky=%s release_after_ms=%d", params.threshold,
+              params.sticky ? "true" : "false", params.release_after_ms);
+  shell_print(sh, "  locked_axis=%s accum_x=%d accum_y=%d", axis_name(state.locked_axis),
+              state.accum_x, state.accum_y);
+  shell_print(sh, "  effective_threshold=%d noise_threshold=%d calibrating=%s",
+              state.effective_threshold, state.noise_threshold,
+              state.calibrating ? "true" : "false");
+  if (IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)) {
+    shell_print(sh, "  shadow_divergences=%u", state.shadow_divergences);
+  }
+}
+
+static int cmd_status(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev;
+
+  if (argc > 1) {
+    dev = find_device(sh, argv[1]);
+    if (dev == NULL) {
+      return -ENODEV;
+    }
+    print_device(sh, dev);
+    return 0;
+  }
+
+  for (size_t i = 0; (dev = zmk_axis_constrain_get_device(i)) != NULL; i++) {
+    print_device(sh, dev);
+  }
+
+  return 0;
+}
+
+static int cmd_set(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev = find_device(sh, argv[1]);
+  int                  err = 0;
+  int                  ret;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  if (strcmp(argv[2], "threshold") == 0) {
+    long value = shell_strtol(argv[3], 10, &err);
+    ret        = err ? err : zmk_axis_constrain_set_threshold(dev, (int)value);
+  } else if (strcmp(argv[2], "sticky") == 0) {
+    bool value = shell_strtobool(argv[3], 10, &err);
+    ret        = err ? err : zmk_axis_constrain_set_sticky(dev, value);
+  } else if (strcmp(argv[2], "release_after_ms") == 0) {
+    long value = shell_strtol(argv[3], 10, &err);
+    ret        = err ? err : zmk_axis_constrain_set_release_after_ms(dev, (int)value);
+  } else {
+    shell_error(sh, "Unknown parameter %s", argv[2]);
+    return -EINVAL;
+  }
+
+  if (ret < 0) {
+    shell_error(sh, "Failed to set %s to %s (%d)", argv[2], argv[3], ret);
+    return ret;
+  }
+
+  return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+static int cmd_latency(const struct shell *sh, size_t argc, char **argv) {
+  const struct device                   *dev = find_device(sh, argv[1]);
+  struct zmk_axis_constrain_latency_hist hist;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  zmk_axis_constrain_get_latency_hist(dev, &hist, argc > 2 && strcmp(argv[2], "reset") == 0);
+
+  shell_print(sh, "%-13s %10s %10s", "bucket", "events", "ms");
+  for (size_t i = 0; i < ZMK_AXIS_CONSTRAIN_LATENCY_BUCKETS; i++) {
+    uint32_t lo = (i == 0) ? 0 : (1U << (i - 1));
+
+    if (i == 0) {
+      shell_print(sh, "%-13s %10u %10u", "0", hist.events[i], hist.ms[i]);
+    } else if (i == ZMK_AXIS_CONSTRAIN_LATENCY_BUCKETS - 1) {
+      shell_print(sh, ">=%-11u %10u %10u", lo, hist.events[i], hist.ms[i]);
+    } else {
+      shell_print(sh, "%5u..%-6u %10u %10u", lo, (1U << i) - 1, hist.events[i], hist.ms[i]);
+    }
+  }
+
+  return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+static void print_cycle_stat(const struct shell *sh, const char *name,
+                             const struct zmk_axis_constrain_cycle_stat *stat) {
+  uint32_t mean = (stat->count == 0) ? 0 : (uint32_t)(stat->total / stat->count);
+
+  shell_print(sh, "%-13s %10u %10u %10u %10u", name, stat->count, stat->min, mean, stat->max);
+}
+
+static int cmd_profile(const struct shell *sh, size_t argc, char **argv) {
+  const struct device              *dev = find_device(sh, argv[1]);
+  struct zmk_axis_constrain_profile profile;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  zmk_axis_constrain_get_profile(dev, &profile, argc > 2 && strcmp(argv[2], "reset") == 0);
+
+  shell_print(sh, "%-13s %10s %10s %10s %10s (cycles, per event for bursts)", "", "count", "min",
+              "mean", "max");
+  print_cycle_stat(sh, "handle_event", &profile.handle_event);
+  for (size_t i = 0; i < ZMK_AXIS_CONSTRAIN_BURST_BUCKETS; i++) {
+    char name[16];
+
+    if (i == 0) {
+      snprintf(name, sizeof(name), "burst 1");
+    } else if (i == ZMK_AXIS_CONSTRAIN_BURST_BUCKETS - 1) {
+      snprintf(name, sizeof(name), "burst >=%u", 1U << i);
+    } else {
+      snprintf(name, sizeof(name), "burst %u..%u", 1U << i, (2U << i) - 1);
+    }
+    print_cycle_stat(sh, name, &profile.handle_events[i]);
+  }
+  print_cycle_stat(sh, "release_work", &profile.release_work);
+  print_cycle_stat(sh, "lock_hold", &profile.lock_hold);
+
+  return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+static int cmd_calibrate(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev = find_device(sh, argv[1]);
+  int                  ret;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  if (argc > 2 && strcmp(argv[2], "cancel") == 0) {
+    ret = zmk_axis_constrain_calibrate_cancel(dev);
+  } else {
+    ret = zmk_axis_constrain_calibrate_start(dev);
+  }
+
+  if (ret < 0) {
+    shell_error(sh, "Calibration request failed (%d)", ret);
+    return ret;
+  }
+
+  return 0;
+}
+#endif
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sub_axis_constrain,
+    SHELL_CMD_ARG(status, NULL, "Dump parameters and live state: status [device]", cmd_status, 1,
+                  1),
+    SHELL_CMD_ARG(set, NULL,
+                  "Set a parameter: set <device> <threshold|sticky|release_after_ms> <value>",
+                  cmd_set, 4, 0),
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+    SHELL_CMD_ARG(latency, NULL, "Print lock latency histograms: latency <device> [reset]",
+                  cmd_latency, 2, 1),
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+    SHELL_CMD_ARG(profile, NULL, "Print hot path cycle counts: profile <device> [reset]",
+                  cmd_profile, 2, 1),
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+    SHELL_CMD_ARG(calibrate, NULL, "Start or cancel calibration: calibrate <device> [cancel]",
+                  cmd_calibrate, 2, 1),
+#endif
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(axis_constrain, &sub_axis_constrain, "Axis constrain input processor", NULL);
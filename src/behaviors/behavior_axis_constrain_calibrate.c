@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_axis_constrain_calibrate
+
+#include <zephyr/device.h>
+#include <zephyr/logging/log.h>
+
+#include <drivers/behavior.h>
+#include <zmk/axis_constrain.h>
+#include <zmk/behavior.h>
+
+LOG_MODULE_DECLARE(axis_constrain, CONFIG_ZMK_LOG_LEVEL);
+
+struct behavior_axis_constrain_calibrate_config {
+  const struct device *processor;
+};
+
+static int on_keymap_binding_pressed(struct zmk_behavior_binding      *binding,
+                                     struct zmk_behavior_binding_event event) {
+  const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+  const struct behavior_axis_constrain_calibrate_config *config = dev->config;
+
+  /* Pressing again while calibrating aborts */
+  if (zmk_axis_constrain_is_calibrating(config->processor)) {
+    zmk_axis_constrain_calibrate_cancel(config->processor);
+  } else {
+    zmk_axis_constrain_calibrate_start(config->processor);
+  }
+
+  return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int on_keymap_binding_released(struct zmk_behavior_binding      *binding,
+                                      struct zmk_behavior_binding_event event) {
+  return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api behavior_axis_constrain_calibrate_api = {
+    .binding_pressed  = on_keymap_binding_pressed,
+    .binding_released = on_keymap_binding_released,
+};
+
+#define ACC_INST(n)                                                                           \
+  static const struct behavior_axis_constrain_calibrate_config                                \
+      behavior_axis_constrain_calibrate_config_##n = {                                        \
+          .processor = DEVICE_DT_GET(DT_INST_PHANDLE(n, input_processor)),                    \
+  };                                                                                          \
+                                                                                              \
+  BEHAVIOR_DT_INST_DEFINE(n, NULL, NULL, NULL, &behavior_axis_constrain_calibrate_config_##n, \
+                          POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,                   \
+                          &behavior_axis_constrain_calibrate_api);
+
+DT_INST_FOREACH_STATUS_OKAY(ACC_INST)
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <zmk/axis_constrain.h>
+
+/*
+ * Frozen reference of the constrain logic for
+ * CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW. It is the original,
+ * straightforward formulation and is what optimized code paths are compared
+ * against: keep it plain, do not optimize or share code with the processor.
+ *
+ * The effective threshold and the release timing are inputs, so only the
+ * accumulate, classify and suppress logic is checked.
+ */
+
+#define AC_REF_MAX_ACCUM (INT32_MAX / 2)
+
+struct ac_reference {
+  enum zmk_axis_constrain_axis locked_axis;
+  int32_t                      accum_x;
+  int32_t                      accum_y;
+};
+
+static inline void ac_reference_reset(struct ac_reference *ref) {
+  ref->locked_axis = ZMK_AXIS_CONSTRAIN_AXIS_NONE;
+  ref->accum_x     = 0;
+  ref->accum_y     = 0;
+}
+
+static inline int32_t ac_reference_abs(int32_t value) {
+  return (value == INT32_MIN) ? INT32_MAX : abs(value);
+}
+
+static inline int32_t ac_reference_add(int32_t current, int32_t delta) {
+  int64_t result = (int64_t)current + (int64_t)delta;
+
+  if (result > AC_REF_MAX_ACCUM) {
+    return AC_REF_MAX_ACCUM;
+  }
+  if (result < -AC_REF_MAX_ACCUM) {
+    return -AC_REF_MAX_ACCUM;
+  }
+  return (int32_t)result;
+}
+
+static inline enum zmk_axis_constrain_axis ac_reference_dominant(const struct ac_reference *ref,
+                                                                 int threshold) {
+  int32_t abs_x = ac_reference_abs(ref->accum_x);
+  int32_t abs_y = ac_reference_abs(ref->accum_y);
+
+  if (abs_x >= threshold && abs_x > abs_y) {
+    return ZMK_AXIS_CONSTRAIN_AXIS_X;
+  }
+  if (abs_y >= threshold && abs_y > abs_x) {
+    return ZMK_AXIS_CONSTRAIN_AXIS_Y;
+  }
+  if (abs_x >= threshold && abs_x == abs_y) {
+    return ZMK_AXIS_CONSTRAIN_AXIS_X;
+  }
+  return ZMK_AXIS_CONSTRAIN_AXIS_NONE;
+}
+
+/** Process one REL_X/REL_Y event and return the value the processor should output. */
+static inline int32_t ac_reference_handle(struct ac_reference *ref, int threshold, bool sticky,
+                                          bool is_x, int32_t value) {
+  enum zmk_axis_constrain_axis own =
+      is_x ? ZMK_AXIS_CONSTRAIN_AXIS_X : ZMK_AXIS_CONSTRAIN_AXIS_Y;
+
+  if (is_x) {
+    ref->accum_x = ac_reference_add(ref->accum_x, value);
+  } else {
+    ref->accum_y = ac_reference_add(ref->accum_y, value);
+  }
+
+  if (sticky) {
+    if (ref->locked_axis == ZMK_AXIS_CONSTRAIN_AXIS_NONE) {
+      ref->locked_axis = ac_reference_dominant(ref, threshold);
+    }
+    return (ref->locked_axis == own) ? value : 0;
+  }
+
+  enum zmk_axis_constrain_axis dominant = ac_reference_dominant(ref, threshold);
+
+  if (dominant != own) {
+    return 0;
+  }
+
+  if (dominant == ZMK_AXIS_CONSTRAIN_AXIS_X) {
+    ref->accum_y = 0;
+    if (ac_reference_abs(ref->accum_x) > threshold) {
+      ref->accum_x = (ref->accum_x > 0) ? threshold : -threshold;
+    }
+  } else {
+    ref->accum_x = 0;
+    if (ac_reference_abs(ref->accum_y) > threshold) {
+      ref->accum_y = (ref->accum_y > 0) ? threshold : -threshold;
+    }
+  }
+  return value;
+}
@@ -5,109 +5,546 @@
 
 #define DT_DRV_COMPAT zmk_input_processor_axis_constrain
 
-#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if (defined(__ARM_FEATURE_DSP) && defined(__ARM_FEATURE_SAT)) || defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
 
 #include <zephyr/device.h>
 #include <zephyr/input/input.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/tracing/tracing.h>
 
 #include <drivers/input_processor.h>
+#include <zmk/axis_constrain.h>
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_RAMFUNC)
+#include <zephyr/linker/section_tags.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+#include "axis_constrain_reference.h"
+#endif
 
 LOG_MODULE_REGISTER(axis_constrain, CONFIG_ZMK_LOG_LEVEL);
 
+/*
+ * The per-event path: AC_HOT functions are placed in RAM with
+ * CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_RAMFUNC, and AC_HOT_INLINE helpers
+ * are forced inline into them so they come along.
+ */
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_RAMFUNC)
+#define AC_HOT        __ramfunc
+#define AC_HOT_INLINE ALWAYS_INLINE
+#else
+#define AC_HOT
+#define AC_HOT_INLINE inline
+#endif
+
+/* Serializes parameter writers across all instances */
+static K_MUTEX_DEFINE(axis_constrain_params_mutex);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS)
+/* A full settings name, e.g. axis_constrain/zip_axis_constrain/release_after_ms */
+#define SETTINGS_PATH_MAX (SETTINGS_MAX_NAME_LEN + 1)
+
+/* Each parameter is stored as axis_constrain/<device>/<name> */
+static const struct {
+  const char *name;
+  size_t      offset;
+  size_t      size;
+} settings_fields[] = {
+    {"threshold", offsetof(struct zmk_axis_constrain_params, threshold), sizeof(int)},
+    {"sticky", offsetof(struct zmk_axis_constrain_params, sticky), sizeof(bool)},
+    {"release_after_ms", offsetof(struct zmk_axis_constrain_params, release_after_ms),
+     sizeof(int)},
+};
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_ACCUM_16BIT)
+typedef int16_t accum_t;
+#define MAX_ACCUM INT16_MAX
+#define ACCUM_BITS 16
+#else
+typedef int32_t accum_t;
 /* Prevent overflow during addition */
 #define MAX_ACCUM (INT32_MAX / 2)
+#define ACCUM_BITS 31
+#endif
 
 enum axis_state {
-  AXIS_NONE = 0,
-  AXIS_X,
-  AXIS_Y,
+  AXIS_NONE = ZMK_AXIS_CONSTRAIN_AXIS_NONE,
+  AXIS_X    = ZMK_AXIS_CONSTRAIN_AXIS_X,
+  AXIS_Y    = ZMK_AXIS_CONSTRAIN_AXIS_Y,
 };
 
+/* EWMA weight of the noise estimator is 1 / 2^NOISE_EWMA_SHIFT */
+#define NOISE_EWMA_SHIFT 5
+/* Samples required before the noise estimate is trusted */
+#define NOISE_MIN_SAMPLES (1 << NOISE_EWMA_SHIFT)
+/* Keeps the squared Q8 deviation of a sample within int32_t */
+#define AUTO_THRESHOLD_LIMIT 64
+
+/* Devicetree defaults; the live values are in the runtime parameter buffers */
 struct axis_constrain_config {
   int  threshold;
   bool sticky;
   int  release_after_ms;
+  bool auto_threshold;
+  int  auto_threshold_k;
+  int  auto_threshold_max;
+  /* Fused scaling of the passed axis, see scale_value() */
+  bool scale;
+  int  scale_multiplier;
+  int  scale_divisor;
+};
+
+/*
+ * Online estimate of sensor jitter. Mean is kept in Q8 and variance in Q16
+ * so that sigma can be derived with an integer square root.
+ */
+struct noise_estimator {
+  int32_t  mean_q8;
+  int32_t  var_q16;
+  uint16_t samples;
+  int      threshold;
+};
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+/*
+ * Calibration records intentional strokes separated by idle gaps. For every
+ * stroke it tracks the largest accumulation the minor axis reached while
+ * leading, i.e. the smallest threshold that would not have mislocked.
+ * Strokes are counted per principal axis so that both are covered.
+ */
+struct calibration {
+  bool                    active;
+  uint16_t                strokes_x;
+  uint16_t                strokes_y;
+  int32_t                 accum_x;
+  int32_t                 accum_y;
+  int32_t                 max_x_lead;
+  int32_t                 max_y_lead;
+  int32_t                 required;
+  int32_t                 min_travel;
+  struct k_work_delayable stroke_work;
+  struct k_work_delayable timeout_work;
 };
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_STATS)
+STATS_SECT_START(axis_constrain)
+STATS_SECT_ENTRY32(events)
+STATS_SECT_ENTRY32(suppressed_prelock)
+STATS_SECT_ENTRY32(suppressed_off_axis)
+STATS_SECT_ENTRY32(locks_x)
+STATS_SECT_ENTRY32(locks_y)
+STATS_SECT_ENTRY32(timeout_releases)
+STATS_SECT_ENTRY32(flips)
+STATS_SECT_ENTRY32(saturations)
+STATS_SECT_END;
+
+STATS_NAME_START(axis_constrain)
+STATS_NAME(axis_constrain, events)
+STATS_NAME(axis_constrain, suppressed_prelock)
+STATS_NAME(axis_constrain, suppressed_off_axis)
+STATS_NAME(axis_constrain, locks_x)
+STATS_NAME(axis_constrain, locks_y)
+STATS_NAME(axis_constrain, timeout_releases)
+STATS_NAME(axis_constrain, flips)
+STATS_NAME(axis_constrain, saturations)
+STATS_NAME_END(axis_constrain);
+
+#define AC_STATS_INC(data, entry)     STATS_INC((data)->stats, entry)
+#define AC_STATS_INCN(data, entry, n) STATS_INCN((data)->stats, entry, n)
+#else
+#define AC_STATS_INC(data, entry)
+#define AC_STATS_INCN(data, entry, n)
+#endif
+
+/*
+ * Named trace events: ac_lock/ac_flip carry the new axis, ac_release the
+ * released one, ac_suppress the event code, the value and whether it happened
+ * before a lock (0) or on the off axis (1) in the upper bit of arg0.
+ */
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_TRACING)
+#define AC_TRACE(name, arg0, arg1) sys_trace_named_event(name, (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define AC_TRACE(name, arg0, arg1)
+#endif
+#define SUPPRESS_PRELOCK  0
+#define SUPPRESS_OFF_AXIS BIT(31)
 
 struct axis_constrain_data {
   const struct device    *dev;
   enum axis_state         locked_axis;
-  int32_t                 accum_x;
-  int32_t                 accum_y;
-  int32_t                 abs_accum_x;
-  int32_t                 abs_accum_y;
+  /* Axis of the previous classified event, used to detect locks and flips */
+  enum axis_state         last_axis;
+  /* Absolute values are derived on demand, see update_accum() */
+  accum_t                 accum_x;
+  accum_t                 accum_y;
+  struct noise_estimator  noise;
   struct k_spinlock       lock;
   struct k_work_delayable release_work;
+  /*
+   * Runtime parameters are double buffered: the event path dereferences the
+   * active buffer only while holding lock, writers fill the inactive one and
+   * swap the pointer.
+   */
+  struct zmk_axis_constrain_params params_buf[2];
+  atomic_ptr_t                     params;
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS)
+  struct k_work_delayable          save_work;
+  /* Values collected by the settings handler until commit */
+  struct zmk_axis_constrain_params loaded;
+  bool                             loaded_pending;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+  struct calibration calib;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_STATS)
+  STATS_SECT_DECL(axis_constrain) stats;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+  /* Events and start time of the motion that has not locked yet */
+  uint32_t                               stroke_events;
+  uint32_t                               stroke_start_ms;
+  struct zmk_axis_constrain_latency_hist latency;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  struct zmk_axis_constrain_profile profile;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+  /* Reference model fed the same events, reset together with this state */
+  struct ac_reference shadow;
+  uint32_t            shadow_events;
+  uint32_t            shadow_divergences;
+#endif
 };
 
 static inline void reset_state_locked(struct axis_constrain_data *data) {
   data->locked_axis = AXIS_NONE;
+  data->last_axis   = AXIS_NONE;
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+  data->stroke_events = 0;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+  ac_reference_reset(&data->shadow);
+#endif
   data->accum_x     = 0;
   data->accum_y     = 0;
-  data->abs_accum_x = 0;
-  data->abs_accum_y = 0;
 }
 
-/* abs(INT32_MIN) is undefined behavior */
-static inline int32_t safe_abs(int32_t value) {
-  if (value == INT32_MIN) {
-    return INT32_MAX;
+/* Branchless; abs(INT32_MIN) is undefined behavior, saturate it instead */
+static AC_HOT_INLINE int32_t safe_abs(int32_t value) {
+  uint32_t sign      = (uint32_t)(value >> 31);
+  uint32_t magnitude = ((uint32_t)value ^ sign) - sign;
+
+  return (int32_t)MIN(magnitude, (uint32_t)INT32_MAX);
+}
+
+/*
+ * current + delta saturated to +-MAX_ACCUM, for current within that range.
+ * Avoids a 64-bit intermediate, which takes several instructions on cores
+ * without a 64-bit add such as Cortex-M0.
+ */
+static AC_HOT_INLINE int32_t safe_accum_add(int32_t current, int32_t delta) {
+#if defined(__ARM_FEATURE_DSP) && defined(__ARM_FEATURE_SAT)
+  BUILD_ASSERT(MAX_ACCUM == BIT(ACCUM_BITS - 1) - 1, "SSAT width must match MAX_ACCUM");
+
+  /* QADD saturates to int32_t, SSAT to [-MAX_ACCUM - 1, MAX_ACCUM]; keep it symmetric */
+  int32_t result = __ssat(__qadd(current, delta), ACCUM_BITS);
+
+  return MAX(result, -MAX_ACCUM);
+#else
+  int32_t result;
+
+  /* With current in range this only overflows for |delta| > MAX_ACCUM */
+  if (__builtin_add_overflow(current, delta, &result)) {
+    return (delta > 0) ? MAX_ACCUM : -MAX_ACCUM;
+  }
+  return CLAMP(result, -MAX_ACCUM, MAX_ACCUM);
+#endif
+}
+
+/*
+ * Absolute values are not cached next to the accumulators: deriving them
+ * takes a few ALU operations, less than keeping two more fields in sync.
+ */
+static AC_HOT_INLINE void update_accum(struct axis_constrain_data *data, bool is_x, int32_t delta) {
+  accum_t *accum = is_x ? &data->accum_x : &data->accum_y;
+
+  *accum = (accum_t)safe_accum_add(*accum, delta);
+
+  if (safe_abs(*accum) == MAX_ACCUM) {
+    AC_STATS_INC(data, saturations);
+  }
+}
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+/* Bucket 0 holds 0, bucket i holds [2^(i-1), 2^i), the last one everything above */
+static AC_HOT_INLINE size_t latency_bucket(uint32_t value) {
+  size_t bucket = (value == 0) ? 0 : (32 - __builtin_clz(value));
+
+  return MIN(bucket, ZMK_AXIS_CONSTRAIN_LATENCY_BUCKETS - 1);
+}
+
+static AC_HOT_INLINE void note_stroke_event(struct axis_constrain_data *data) {
+  if (data->last_axis != AXIS_NONE) {
+    return;
+  }
+  if (data->stroke_events == 0) {
+    data->stroke_start_ms = k_uptime_get_32();
+  }
+  data->stroke_events++;
+}
+
+static AC_HOT_INLINE void record_lock_latency(struct axis_constrain_data *data) {
+  uint32_t elapsed_ms = k_uptime_get_32() - data->stroke_start_ms;
+
+  data->latency.events[latency_bucket(data->stroke_events)]++;
+  data->latency.ms[latency_bucket(elapsed_ms)]++;
+  data->stroke_events = 0;
+}
+#endif
+
+/* Track transitions of the classified axis for the statistics */
+static AC_HOT_INLINE void note_axis_locked(struct axis_constrain_data *data, enum axis_state axis) {
+  if (axis == data->last_axis) {
+    return;
+  }
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+  if (data->last_axis == AXIS_NONE) {
+    record_lock_latency(data);
   }
-  return abs(value);
+#endif
+
+  if (axis == AXIS_X) {
+    AC_STATS_INC(data, locks_x);
+  } else if (axis == AXIS_Y) {
+    AC_STATS_INC(data, locks_y);
+  }
+  if (axis != AXIS_NONE && data->last_axis != AXIS_NONE) {
+    AC_STATS_INC(data, flips);
+    AC_TRACE("ac_flip", axis, 0);
+  } else if (axis != AXIS_NONE) {
+    AC_TRACE("ac_lock", axis, 0);
+  }
+
+  data->last_axis = axis;
 }
 
-static inline int32_t safe_accum_add(int32_t current, int32_t delta) {
-  int64_t result = (int64_t)current + (int64_t)delta;
-  if (result > MAX_ACCUM) {
-    return MAX_ACCUM;
+static AC_HOT_INLINE uint32_t isqrt32(uint32_t value) {
+  uint32_t result = 0;
+  uint32_t bit    = 1UL << 30;
+
+  while (bit > value) {
+    bit >>= 2;
   }
-  if (result < -MAX_ACCUM) {
-    return -MAX_ACCUM;
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
   }
-  return (int32_t)result;
+  return result;
 }
 
-static inline void update_accum(struct axis_constrain_data *data, bool is_x, int32_t delta) {
-  if (is_x) {
-    data->accum_x     = safe_accum_add(data->accum_x, delta);
-    data->abs_accum_x = safe_abs(data->accum_x);
-  } else {
-    data->accum_y     = safe_accum_add(data->accum_y, delta);
-    data->abs_accum_y = safe_abs(data->accum_y);
+static AC_HOT_INLINE int
+effective_threshold_locked(const struct axis_constrain_data       *data,
+                           const struct zmk_axis_constrain_params *params) {
+  return MAX(params->threshold, data->noise.threshold);
+}
+
+/*
+ * Feed a delta observed while idle (i.e. sensor jitter) into the noise
+ * estimator and derive the effective threshold as k * sigma, never below the
+ * configured threshold and never above auto_threshold_max.
+ *
+ * Samples are admitted from the fixed window of auto_threshold_max, not below
+ * the effective threshold: that is the estimator's own output, and cutting
+ * the samples off there would pull every estimate towards the floor. Idle
+ * means no axis is determined and neither accumulator has left the window
+ * since the last reset. That bounds what a stroke contributes without
+ * excluding it: its first reports are admitted as jitter until one of the
+ * accumulators leaves the window, at most a window's worth of motion.
+ */
+static AC_HOT void update_noise_estimate(struct axis_constrain_data         *data,
+                                         const struct axis_constrain_config *config,
+                                         int32_t                             delta) {
+  struct noise_estimator *noise  = &data->noise;
+  int32_t                 window = config->auto_threshold_max;
+
+  if (!config->auto_threshold || safe_abs(delta) >= window || safe_abs(data->accum_x) >= window ||
+      safe_abs(data->accum_y) >= window) {
+    return;
   }
+
+  int32_t diff_q8 = (delta * 256) - noise->mean_q8;
+  noise->mean_q8 += diff_q8 / (1 << NOISE_EWMA_SHIFT);
+  noise->var_q16 += ((diff_q8 * diff_q8) - noise->var_q16) / (1 << NOISE_EWMA_SHIFT);
+
+  if (noise->samples < NOISE_MIN_SAMPLES) {
+    noise->samples++;
+    return;
+  }
+
+  uint32_t sigma_q8  = isqrt32((uint32_t)noise->var_q16);
+  int      estimated = (int)(((uint32_t)config->auto_threshold_k * sigma_q8 + 255) >> 8);
+
+  noise->threshold = MIN(estimated, config->auto_threshold_max);
 }
 
-static enum axis_state determine_dominant_axis(struct axis_constrain_data *data, int threshold) {
-  if (data->abs_accum_x >= threshold && data->abs_accum_x > data->abs_accum_y) {
+static AC_HOT_INLINE enum axis_state determine_dominant_axis(struct axis_constrain_data *data,
+                                                             int threshold) {
+  int32_t abs_x = safe_abs(data->accum_x);
+  int32_t abs_y = safe_abs(data->accum_y);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_BRANCHLESS_CLASSIFIER)
+  BUILD_ASSERT(AXIS_X == 1 && AXIS_Y == 2, "axis values are used as bits");
+
+  /*
+   * The same decision as below, from comparison results combined into the
+   * enum instead of data-dependent branches, which mispredict on
+   * near-diagonal motion. Ties go to X.
+   */
+  unsigned int x_wins = (abs_x >= abs_y);
+  unsigned int ge_x   = (abs_x >= threshold);
+  unsigned int ge_y   = (abs_y >= threshold);
+
+  return (enum axis_state)((ge_x & x_wins) | ((ge_y & !x_wins) << 1));
+#else
+  if (abs_x >= threshold && abs_x > abs_y) {
     return AXIS_X;
   }
-  if (data->abs_accum_y >= threshold && data->abs_accum_y > data->abs_accum_x) {
+  if (abs_y >= threshold && abs_y > abs_x) {
     return AXIS_Y;
   }
   /* Prefer X when equal for deterministic behavior */
-  if (data->abs_accum_x >= threshold && data->abs_accum_x == data->abs_accum_y) {
+  if (abs_x >= threshold && abs_x == abs_y) {
     return AXIS_X;
   }
   return AXIS_NONE;
+#endif
+}
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+static inline void cycle_stat_add(struct zmk_axis_constrain_cycle_stat *stat, uint32_t cycles) {
+  if (stat->count == 0 || cycles < stat->min) {
+    stat->min = cycles;
+  }
+  if (cycles > stat->max) {
+    stat->max = cycles;
+  }
+  stat->total += cycles;
+  stat->count++;
+}
+
+/*
+ * Bookkeeping runs after the exit timestamp is taken, in its own critical
+ * section, so it is not part of what it measures.
+ */
+static void profile_record(struct axis_constrain_data          *data,
+                           struct zmk_axis_constrain_cycle_stat *stat, uint32_t events,
+                           uint32_t entry, uint32_t locked, uint32_t unlocking) {
+  uint32_t exit = k_cycle_get_32();
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  cycle_stat_add(stat, (exit - entry) / events);
+  cycle_stat_add(&data->profile.lock_hold, unlocking - locked);
+  k_spin_unlock(&data->lock, key);
+}
+
+/* Bucket i holds bursts of [2^i, 2^(i+1)) events, the last one everything above */
+static inline size_t burst_bucket(size_t count) {
+  size_t bucket = 31 - __builtin_clz((uint32_t)MIN(count, UINT32_MAX));
+
+  return MIN(bucket, ZMK_AXIS_CONSTRAIN_BURST_BUCKETS - 1);
 }
+#endif
 
 static void release_work_handler(struct k_work *work) {
   struct k_work_delayable    *dwork = k_work_delayable_from_work(work);
   struct axis_constrain_data *data  = CONTAINER_OF(dwork, struct axis_constrain_data, release_work);
 
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t entry_cycles = k_cycle_get_32();
+#endif
+
   k_spinlock_key_t key = k_spin_lock(&data->lock);
 
-  LOG_DBG("Releasing axis lock (was: %s)",
-          data->locked_axis == AXIS_X ? "X" : (data->locked_axis == AXIS_Y ? "Y" : "NONE"));
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t locked_cycles = k_cycle_get_32();
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LOG_EVENTS)
+  enum axis_state released = data->locked_axis;
+#endif
+
+  if (data->locked_axis != AXIS_NONE) {
+    AC_STATS_INC(data, timeout_releases);
+    AC_TRACE("ac_release", data->locked_axis, 0);
+  }
 
   reset_state_locked(data);
 
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t unlocking_cycles = k_cycle_get_32();
+#endif
+
   k_spin_unlock(&data->lock, key);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  profile_record(data, &data->profile.release_work, 1, entry_cycles, locked_cycles,
+                 unlocking_cycles);
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LOG_EVENTS)
+  LOG_DBG("Releasing axis lock (was: %s)",
+          released == AXIS_X ? "X" : (released == AXIS_Y ? "Y" : "NONE"));
+#endif
 }
 
-#if defined(CONFIG_LOG)
+enum suppress_reason {
+  SUPPRESS_NONE = 0,
+  SUPPRESS_BELOW_THRESHOLD,
+  SUPPRESS_NOT_LOCKED_AXIS,
+  SUPPRESS_NOT_DOMINANT_AXIS,
+};
+
+/*
+ * What happened to one event, captured inside the critical section and
+ * logged after it is left. When per-event logging is disabled the compiler
+ * drops the stores since nothing reads them.
+ */
+struct event_log {
+  enum axis_state      locked;
+  enum suppress_reason reason;
+  enum axis_state      axis;
+  bool                 is_x;
+  int32_t              value;
+  int32_t              abs_accum_x;
+  int32_t              abs_accum_y;
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+  /* Set for the first event that diverged from the reference model */
+  bool                 diverged;
+  uint32_t             shadow_event;
+  int32_t              input;
+  int32_t              output;
+  int32_t              expected;
+#endif
+};
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LOG_EVENTS)
 static inline const char *axis_name(enum axis_state axis) {
   switch (axis) {
     case AXIS_X:
@@ -118,23 +555,62 @@ static inline const char *axis_name(enum axis_state axis) {
       return "NONE";
   }
 }
+
+static void emit_event_log(const struct event_log *log) {
+  if (log->locked != AXIS_NONE) {
+    LOG_DBG("Locked to %s axis (abs_accum_x=%d, abs_accum_y=%d)", axis_name(log->locked),
+            log->abs_accum_x, log->abs_accum_y);
+  }
+
+  switch (log->reason) {
+    case SUPPRESS_BELOW_THRESHOLD:
+      LOG_DBG("Below threshold, suppressed %s: %d (abs_accum_x=%d, abs_accum_y=%d)",
+              log->is_x ? "X" : "Y", log->value, log->abs_accum_x, log->abs_accum_y);
+      break;
+    case SUPPRESS_NOT_LOCKED_AXIS:
+      LOG_DBG("Suppressed %s: %d (locked: %s)", log->is_x ? "X" : "Y", log->value,
+              axis_name(log->axis));
+      break;
+    case SUPPRESS_NOT_DOMINANT_AXIS:
+      LOG_DBG("Suppressed %s: %d (dominant: %s)", log->is_x ? "X" : "Y", log->value,
+              axis_name(log->axis));
+      break;
+    default:
+      break;
+  }
+}
 #endif
 
-static void handle_sticky_mode(struct axis_constrain_data         *data,
-                               const struct axis_constrain_config *config,
-                               struct input_event *event, bool is_x) {
+static AC_HOT_INLINE void capture_suppression(struct event_log *log, enum suppress_reason reason,
+                                              enum axis_state axis, const struct input_event *event,
+                                              const struct axis_constrain_data *data) {
+  log->reason      = reason;
+  log->axis        = axis;
+  log->value       = event->value;
+  log->abs_accum_x = safe_abs(data->accum_x);
+  log->abs_accum_y = safe_abs(data->accum_y);
+}
+
+static AC_HOT_INLINE void handle_sticky_mode(struct axis_constrain_data         *data,
+                                             const struct axis_constrain_config *config,
+                                             int threshold, struct input_event *event, bool is_x,
+                                             struct event_log *log) {
   if (data->locked_axis == AXIS_NONE) {
-    data->locked_axis = determine_dominant_axis(data, config->threshold);
+    data->locked_axis = determine_dominant_axis(data, threshold);
 
     if (data->locked_axis != AXIS_NONE) {
-      LOG_DBG("Locked to %s axis (abs_accum_x=%d, abs_accum_y=%d)", axis_name(data->locked_axis),
-              data->abs_accum_x, data->abs_accum_y);
+      log->locked      = data->locked_axis;
+      log->abs_accum_x = safe_abs(data->accum_x);
+      log->abs_accum_y = safe_abs(data->accum_y);
+      note_axis_locked(data, data->locked_axis);
     }
   }
 
   if (data->locked_axis == AXIS_NONE) {
-    LOG_DBG("Below threshold, suppressed %s: %d (abs_accum_x=%d, abs_accum_y=%d)", is_x ? "X" : "Y",
-            event->value, data->abs_accum_x, data->abs_accum_y);
+    capture_suppression(log, SUPPRESS_BELOW_THRESHOLD, AXIS_NONE, event, data);
+    update_noise_estimate(data, config, event->value);
+    AC_STATS_INC(data, suppressed_prelock);
+    AC_TRACE("ac_suppress", SUPPRESS_PRELOCK | event->code, event->value);
     event->value = 0;
     return;
   }
@@ -143,20 +619,26 @@ static void handle_sticky_mode(struct axis_constrain_data         *data,
       (data->locked_axis == AXIS_X && is_x) || (data->locked_axis == AXIS_Y && !is_x);
 
   if (!is_locked_axis) {
-    LOG_DBG("Suppressed %s: %d (locked: %s)", is_x ? "X" : "Y", event->value,
-            axis_name(data->locked_axis));
+    capture_suppression(log, SUPPRESS_NOT_LOCKED_AXIS, data->locked_axis, event, data);
+    AC_STATS_INC(data, suppressed_off_axis);
+    AC_TRACE("ac_suppress", SUPPRESS_OFF_AXIS | event->code, event->value);
     event->value = 0;
   }
 }
 
-static void handle_non_sticky_mode(struct axis_constrain_data         *data,
-                                   const struct axis_constrain_config *config,
-                                   struct input_event *event, bool is_x) {
-  enum axis_state dominant = determine_dominant_axis(data, config->threshold);
+static AC_HOT_INLINE void handle_non_sticky_mode(struct axis_constrain_data         *data,
+                                                 const struct axis_constrain_config *config,
+                                                 int threshold, struct input_event *event,
+                                                 bool is_x, struct event_log *log) {
+  enum axis_state dominant = determine_dominant_axis(data, threshold);
+
+  note_axis_locked(data, dominant);
 
   if (dominant == AXIS_NONE) {
-    LOG_DBG("Below threshold, suppressed %s: %d (abs_accum_x=%d, abs_accum_y=%d)", is_x ? "X" : "Y",
-            event->value, data->abs_accum_x, data->abs_accum_y);
+    capture_suppression(log, SUPPRESS_BELOW_THRESHOLD, AXIS_NONE, event, data);
+    update_noise_estimate(data, config, event->value);
+    AC_STATS_INC(data, suppressed_prelock);
+    AC_TRACE("ac_suppress", SUPPRESS_PRELOCK | event->code, event->value);
     event->value = 0;
     return;
   }
@@ -164,8 +646,9 @@ static void handle_non_sticky_mode(struct axis_constrain_data         *data,
   bool is_dominant = (dominant == AXIS_X && is_x) || (dominant == AXIS_Y && !is_x);
 
   if (!is_dominant) {
-    LOG_DBG("Suppressed %s: %d (dominant: %s)", is_x ? "X" : "Y", event->value,
-            axis_name(dominant));
+    capture_suppression(log, SUPPRESS_NOT_DOMINANT_AXIS, dominant, event, data);
+    AC_STATS_INC(data, suppressed_off_axis);
+    AC_TRACE("ac_suppress", SUPPRESS_OFF_AXIS | event->code, event->value);
     event->value = 0;
   } else {
     /*
@@ -174,90 +657,1007 @@ static void handle_non_sticky_mode(struct axis_constrain_data         *data,
      * easier to switch directions after sustained movement.
      */
     if (dominant == AXIS_X) {
-      data->accum_y     = 0;
-      data->abs_accum_y = 0;
-      if (data->abs_accum_x > config->threshold) {
-        data->accum_x     = (data->accum_x > 0) ? config->threshold : -config->threshold;
-        data->abs_accum_x = config->threshold;
-      }
+      data->accum_y = 0;
+      data->accum_x = (accum_t)CLAMP(data->accum_x, -threshold, threshold);
     } else {
-      data->accum_x     = 0;
-      data->abs_accum_x = 0;
-      if (data->abs_accum_y > config->threshold) {
-        data->accum_y     = (data->accum_y > 0) ? config->threshold : -config->threshold;
-        data->abs_accum_y = config->threshold;
-      }
+      data->accum_x = 0;
+      data->accum_y = (accum_t)CLAMP(data->accum_y, -threshold, threshold);
     }
   }
 }
 
-static int axis_constrain_handle_event(const struct device *dev, struct input_event *event,
-                                       uint32_t param1, uint32_t param2,
-                                       struct zmk_input_processor_state *state) {
-  const struct axis_constrain_config *config = dev->config;
-  struct axis_constrain_data         *data   = dev->data;
+/*
+ * Properties the event path keeps whatever the implementation details, e.g.
+ * saturating arithmetic or a different classifier. Checked with
+ * CONFIG_ASSERT=y, compiled out otherwise.
+ */
+static AC_HOT_INLINE void check_invariants_locked(const struct axis_constrain_data *data,
+                                                  const struct input_event *event, int32_t input,
+                                                  bool is_x) {
+  __ASSERT(event->value == 0 || event->value == input, "output %d from input %d", event->value,
+           input);
+  __ASSERT(data->accum_x >= -MAX_ACCUM && data->accum_x <= MAX_ACCUM, "accum_x %d",
+           data->accum_x);
+  __ASSERT(data->accum_y >= -MAX_ACCUM && data->accum_y <= MAX_ACCUM, "accum_y %d",
+           data->accum_y);
+  /* Only sticky mode locks, and changing the mode resets the lock */
+  __ASSERT(data->locked_axis == AXIS_NONE || event->value == 0 ||
+               (data->locked_axis == AXIS_X) == is_x,
+           "motion on %s passed while locked to the other axis", is_x ? "X" : "Y");
+}
 
-  if (event->type != INPUT_EV_REL) {
-    return 0;
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+/*
+ * Feed the event to the reference model and count disagreements in the
+ * output or, in sticky mode, the locked axis. Returns true for the first one,
+ * with the details in log so that it can be reported after unlocking.
+ */
+static bool shadow_check_locked(struct axis_constrain_data *data, int threshold, bool sticky,
+                                bool is_x, int32_t input, int32_t output, struct event_log *log) {
+  int32_t expected = ac_reference_handle(&data->shadow, threshold, sticky, is_x, input);
+
+  data->shadow_events++;
+
+  if (expected == output &&
+      (!sticky || (enum zmk_axis_constrain_axis)data->locked_axis == data->shadow.locked_axis)) {
+    return false;
   }
 
-  if (event->code != INPUT_REL_X && event->code != INPUT_REL_Y) {
-    return 0;
+  data->shadow_divergences++;
+  log->shadow_event = data->shadow_events;
+  log->input        = input;
+  log->output       = output;
+  log->expected     = expected;
+
+  return data->shadow_divergences == 1;
+}
+
+static void emit_divergence_log(const struct event_log *log) {
+  if (log->diverged) {
+    LOG_ERR("Event %u diverged from the reference model: %s %d -> %d, expected %d",
+            log->shadow_event, log->is_x ? "X" : "Y", log->input, log->output, log->expected);
+  }
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+static AC_HOT_INLINE void calibration_record_locked(struct calibration *calib, bool is_x,
+                                                   int32_t delta) {
+  if (is_x) {
+    calib->accum_x = safe_accum_add(calib->accum_x, delta);
+  } else {
+    calib->accum_y = safe_accum_add(calib->accum_y, delta);
   }
 
-  bool is_x = (event->code == INPUT_REL_X);
+  int32_t abs_x = safe_abs(calib->accum_x);
+  int32_t abs_y = safe_abs(calib->accum_y);
+
+  /* Ties lock to X, see determine_dominant_axis */
+  if (abs_x >= abs_y) {
+    calib->max_x_lead = MAX(calib->max_x_lead, abs_x);
+  } else {
+    calib->max_y_lead = MAX(calib->max_y_lead, abs_y);
+  }
+}
+
+static void calibration_stroke_work_handler(struct k_work *work) {
+  struct k_work_delayable    *dwork = k_work_delayable_from_work(work);
+  struct calibration         *calib = CONTAINER_OF(dwork, struct calibration, stroke_work);
+  struct axis_constrain_data *data  = CONTAINER_OF(calib, struct axis_constrain_data, calib);
+  bool                        done  = false;
+  int                         threshold = 0;
 
   k_spinlock_key_t key = k_spin_lock(&data->lock);
 
-  update_accum(data, is_x, event->value);
+  if (!calib->active) {
+    k_spin_unlock(&data->lock, key);
+    return;
+  }
+
+  int32_t abs_x  = safe_abs(calib->accum_x);
+  int32_t abs_y  = safe_abs(calib->accum_y);
+  int32_t travel = MAX(abs_x, abs_y);
 
-  if (config->sticky) {
-    k_work_reschedule(&data->release_work, K_MSEC(config->release_after_ms));
-    handle_sticky_mode(data, config, event, is_x);
-  } else {
-    handle_non_sticky_mode(data, config, event, is_x);
+  if (travel >= CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION_MIN_TRAVEL) {
+    /* Smallest threshold at which the minor axis never took the lock */
+    int32_t required = 1 + ((abs_x >= abs_y) ? calib->max_y_lead : calib->max_x_lead);
+
+    calib->required   = MAX(calib->required, required);
+    calib->min_travel = MIN(calib->min_travel, travel);
+    if (abs_x >= abs_y) {
+      calib->strokes_x++;
+    } else {
+      calib->strokes_y++;
+    }
+  }
+
+  calib->accum_x    = 0;
+  calib->accum_y    = 0;
+  calib->max_x_lead = 0;
+  calib->max_y_lead = 0;
+
+  /* A threshold from strokes along one axis says nothing about mislocks on the other */
+  if (calib->strokes_x + calib->strokes_y >=
+          CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION_STROKES &&
+      calib->strokes_x > 0 && calib->strokes_y > 0) {
+    done          = true;
+    calib->active = false;
+    if (calib->required <= calib->min_travel) {
+      threshold = calib->required;
+    }
   }
 
   k_spin_unlock(&data->lock, key);
 
-  return 0;
+  if (!done) {
+    return;
+  }
+
+  k_work_cancel_delayable(&calib->timeout_work);
+
+  if (threshold == 0) {
+    LOG_WRN("Calibration failed: strokes need threshold %d but travel only %d", calib->required,
+            calib->min_travel);
+    return;
+  }
+
+  int ret = zmk_axis_constrain_set_threshold(data->dev, threshold);
+  if (ret < 0) {
+    LOG_ERR("Failed to apply calibrated threshold %d (%d)", threshold, ret);
+    return;
+  }
+
+  LOG_INF("Calibrated threshold=%d", threshold);
 }
 
-static struct zmk_input_processor_driver_api axis_constrain_api = {
-    .handle_event = axis_constrain_handle_event,
-};
+static void calibration_timeout_work_handler(struct k_work *work) {
+  struct k_work_delayable    *dwork = k_work_delayable_from_work(work);
+  struct calibration         *calib = CONTAINER_OF(dwork, struct calibration, timeout_work);
+  struct axis_constrain_data *data  = CONTAINER_OF(calib, struct axis_constrain_data, calib);
 
-static int axis_constrain_init(const struct device *dev) {
-  struct axis_constrain_data         *data   = dev->data;
-  const struct axis_constrain_config *config = dev->config;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  bool             was_active = calib->active;
+  calib->active               = false;
+  k_spin_unlock(&data->lock, key);
 
-  data->dev = dev;
+  if (was_active) {
+    k_work_cancel_delayable(&calib->stroke_work);
+    LOG_WRN("Calibration timed out after %d horizontal and %d vertical strokes",
+            calib->strokes_x, calib->strokes_y);
+  }
+}
+
+int zmk_axis_constrain_calibrate_start(const struct device *dev) {
+  struct axis_constrain_data *data  = dev->data;
+  struct calibration         *calib = &data->calib;
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  if (calib->active) {
+    k_spin_unlock(&data->lock, key);
+    return -EBUSY;
+  }
+
+  calib->active     = true;
+  calib->strokes_x  = 0;
+  calib->strokes_y  = 0;
+  calib->accum_x    = 0;
+  calib->accum_y    = 0;
+  calib->max_x_lead = 0;
+  calib->max_y_lead = 0;
+  calib->required   = 1;
+  calib->min_travel = MAX_ACCUM;
   reset_state_locked(data);
-  k_work_init_delayable(&data->release_work, release_work_handler);
 
-  LOG_DBG("Initialized (threshold=%d, sticky=%s, release_after_ms=%d)", config->threshold,
-          config->sticky ? "true" : "false", config->release_after_ms);
+  k_spin_unlock(&data->lock, key);
+
+  k_work_reschedule(&calib->timeout_work,
+                    K_MSEC(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION_TIMEOUT_MS));
+
+  LOG_INF("Calibration started: make %d horizontal and vertical strokes",
+          CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION_STROKES);
 
   return 0;
 }
 
-#define AC_INST(n)                                                                  \
-  BUILD_ASSERT(DT_INST_PROP(n, threshold) > 0, "threshold must be greater than 0"); \
-  BUILD_ASSERT(!DT_INST_PROP(n, sticky) || DT_INST_PROP(n, release_after_ms) > 0,   \
-               "release_after_ms must be > 0 when sticky mode is enabled");         \
-                                                                                    \
-  static struct axis_constrain_data axis_constrain_data_##n = {                     \
-      .lock = {},                                                                   \
-  };                                                                                \
-                                                                                    \
-  static const struct axis_constrain_config axis_constrain_config_##n = {           \
-      .threshold        = DT_INST_PROP(n, threshold),                               \
-      .sticky           = DT_INST_PROP(n, sticky),                                  \
-      .release_after_ms = DT_INST_PROP(n, release_after_ms),                        \
-  };                                                                                \
-                                                                                    \
-  DEVICE_DT_INST_DEFINE(n, axis_constrain_init, NULL, &axis_constrain_data_##n,     \
-                        &axis_constrain_config_##n, POST_KERNEL,                    \
-                        CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &axis_constrain_api);
+int zmk_axis_constrain_calibrate_cancel(const struct device *dev) {
+  struct axis_constrain_data *data  = dev->data;
+  struct calibration         *calib = &data->calib;
 
-DT_INST_FOREACH_STATUS_OKAY(AC_INST)
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  bool             was_active = calib->active;
+  calib->active               = false;
+  k_spin_unlock(&data->lock, key);
+
+  if (!was_active) {
+    return -EALREADY;
+  }
+
+  k_work_cancel_delayable(&calib->stroke_work);
+  k_work_cancel_delayable(&calib->timeout_work);
+
+  LOG_INF("Calibration cancelled");
+
+  return 0;
+}
+
+bool zmk_axis_constrain_is_calibrating(const struct device *dev) {
+  struct axis_constrain_data *data = dev->data;
+
+  k_spinlock_key_t key    = k_spin_lock(&data->lock);
+  bool             active = data->calib.active;
+  k_spin_unlock(&data->lock, key);
+
+  return active;
+}
+#endif /* CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION */
+
+/*
+ * The arithmetic of zmk,input-processor-scaler, so that the fused scale
+ * matches a &zip_xy_scaler after this processor: the remainder of the
+ * division is carried to the next event when there is one to carry it in.
+ * Values are clamped to int16_t like the scaler's, which keeps the product
+ * within int32_t.
+ */
+static AC_HOT_INLINE int32_t scale_value(const struct axis_constrain_config *config, int32_t value,
+                                         int16_t *remainder) {
+  int32_t product = CLAMP(value, -INT16_MAX, INT16_MAX) * config->scale_multiplier;
+
+  if (remainder != NULL) {
+    product += *remainder;
+  }
+
+  int32_t scaled = product / config->scale_divisor;
+
+  if (remainder != NULL) {
+    *remainder = (int16_t)(product - scaled * config->scale_divisor);
+  }
+  return scaled;
+}
+
+/*
+ * With the fused scale, events left at 0 end here instead of passing through
+ * the rest of the chain, unless they carry the sync that completes a report.
+ */
+static AC_HOT_INLINE int scale_event(const struct axis_constrain_config *config,
+                                     struct input_event                 *event,
+                                     struct zmk_input_processor_state   *state) {
+  if (!config->scale) {
+    return ZMK_INPUT_PROC_CONTINUE;
+  }
+
+  event->value = scale_value(config, event->value, (state != NULL) ? state->remainder : NULL);
+
+  return (event->value == 0 && !event->sync) ? ZMK_INPUT_PROC_STOP : ZMK_INPUT_PROC_CONTINUE;
+}
+
+/*
+ * Run one REL_X/REL_Y event through the classifier and rewrite its value.
+ * The caller holds data->lock and reschedules the release work, so that a
+ * batch does it once.
+ */
+static AC_HOT_INLINE void constrain_event_locked(struct axis_constrain_data             *data,
+                                                 const struct axis_constrain_config     *config,
+                                                 const struct zmk_axis_constrain_params *params,
+                                                 struct input_event *event, bool is_x,
+                                                 struct event_log *log) {
+  int32_t input     = event->value;
+  int     threshold = effective_threshold_locked(data, params);
+
+  update_accum(data, is_x, input);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+  note_stroke_event(data);
+#endif
+
+  if (params->sticky) {
+    handle_sticky_mode(data, config, threshold, event, is_x, log);
+  } else {
+    handle_non_sticky_mode(data, config, threshold, event, is_x, log);
+  }
+
+  check_invariants_locked(data, event, input, is_x);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+  log->diverged = shadow_check_locked(data, threshold, params->sticky, is_x, input, event->value,
+                                      log);
+#endif
+}
+
+static AC_HOT int axis_constrain_handle_event(const struct device *dev, struct input_event *event,
+                                              uint32_t param1, uint32_t param2,
+                                              struct zmk_input_processor_state *state) {
+  const struct axis_constrain_config *config = dev->config;
+  struct axis_constrain_data         *data   = dev->data;
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t entry_cycles = k_cycle_get_32();
+#endif
+
+  if (event->type != INPUT_EV_REL) {
+    return 0;
+  }
+
+  if (event->code != INPUT_REL_X && event->code != INPUT_REL_Y) {
+    return 0;
+  }
+
+  bool             is_x = (event->code == INPUT_REL_X);
+  struct event_log log  = {.is_x = is_x};
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t locked_cycles = k_cycle_get_32();
+#endif
+
+  AC_STATS_INC(data, events);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+  /* Strokes pass through unconstrained while calibrating */
+  if (data->calib.active) {
+    calibration_record_locked(&data->calib, is_x, event->value);
+    k_work_reschedule(&data->calib.stroke_work,
+                      K_MSEC(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION_STROKE_GAP_MS));
+    k_spin_unlock(&data->lock, key);
+    return scale_event(config, event, state);
+  }
+#endif
+
+  const struct zmk_axis_constrain_params *params = atomic_ptr_get(&data->params);
+
+  if (params->sticky) {
+    k_work_reschedule(&data->release_work, K_MSEC(params->release_after_ms));
+  }
+
+  constrain_event_locked(data, config, params, event, is_x, &log);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t unlocking_cycles = k_cycle_get_32();
+#endif
+
+  k_spin_unlock(&data->lock, key);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  profile_record(data, &data->profile.handle_event, 1, entry_cycles, locked_cycles,
+                 unlocking_cycles);
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LOG_EVENTS)
+  emit_event_log(&log);
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+  emit_divergence_log(&log);
+#endif
+
+  return scale_event(config, event, state);
+}
+
+static AC_HOT_INLINE bool is_motion(const struct input_event *event) {
+  return event->type == INPUT_EV_REL &&
+         (event->code == INPUT_REL_X || event->code == INPUT_REL_Y);
+}
+
+static AC_HOT_INLINE bool calibrating_locked(const struct axis_constrain_data *data) {
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+  return data->calib.active;
+#else
+  return false;
+#endif
+}
+
+/*
+ * Sticky mode with an axis locked passes that axis, zeroes the other and
+ * only accumulates; nothing depends on the outcome of the previous event.
+ * When no partial sum can reach MAX_ACCUM, saturation cannot change the
+ * result either, so a whole burst reduces to a maximum, two sums and a mask,
+ * written without data-dependent branches so that the compiler can
+ * vectorize them. Returns false without changing anything if the burst
+ * could saturate.
+ */
+static AC_HOT bool constrain_locked_burst_locked(struct axis_constrain_data *data,
+                                                 struct input_event *events, size_t count,
+                                                 int threshold, size_t *motion,
+                                                 struct event_log *divergence) {
+  uint16_t locked_code = (data->locked_axis == AXIS_X) ? INPUT_REL_X : INPUT_REL_Y;
+  int32_t  headroom    = MAX_ACCUM - MAX(safe_abs(data->accum_x), safe_abs(data->accum_y));
+  uint32_t max_abs     = 0;
+
+  /* Over all events, not only motion: stricter, but a plain reduction */
+  for (size_t i = 0; i < count; i++) {
+    max_abs = MAX(max_abs, (uint32_t)safe_abs(events[i].value));
+  }
+
+  /* Every partial sum stays below MAX_ACCUM if count * max_abs < headroom */
+  if (headroom <= 0 || (max_abs != 0 && count > (uint32_t)(headroom - 1) / max_abs)) {
+    return false;
+  }
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW) ||                  \
+    IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_TRACING)
+  /* Per-event diagnostics need the inputs, so they run before the mask */
+  for (size_t i = 0; i < count; i++) {
+    const struct input_event *event = &events[i];
+    bool                      off   = (event->code != locked_code);
+
+    if (!is_motion(event)) {
+      continue;
+    }
+    if (off) {
+      AC_TRACE("ac_suppress", SUPPRESS_OFF_AXIS | event->code, event->value);
+    }
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+    struct event_log log = {.is_x = (event->code == INPUT_REL_X)};
+
+    log.diverged = shadow_check_locked(data, threshold, true, log.is_x, event->value,
+                                       off ? 0 : event->value, &log);
+    if (log.diverged) {
+      *divergence = log;
+    }
+#endif
+  }
+#endif
+
+  uint32_t moved    = 0;
+  uint32_t off_axis = 0;
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_ACCUM_16BIT) &&             \
+    defined(__ARM_FEATURE_SIMD32)
+  /* Both accumulators in one word, X in the low halfword, added with one SADD16 per event */
+  uint32_t accum = (uint16_t)data->accum_x | ((uint32_t)(uint16_t)data->accum_y << 16);
+
+  for (size_t i = 0; i < count; i++) {
+    struct input_event *event = &events[i];
+    uint32_t            is_x  = is_motion(event) && event->code == INPUT_REL_X;
+    uint32_t            is_y  = is_motion(event) && event->code == INPUT_REL_Y;
+    uint32_t            delta = (uint16_t)event->value;
+
+    accum = (uint32_t)__sadd16((int16x2_t)accum, (int16x2_t)((delta & -is_x) |
+                                                             ((delta & -is_y) << 16)));
+    moved += is_x | is_y;
+    off_axis += (is_x | is_y) & (event->code != locked_code);
+    event->value &= -(int32_t)(!(is_x | is_y) || event->code == locked_code);
+  }
+
+  data->accum_x = (accum_t)(int16_t)(accum & 0xFFFF);
+  data->accum_y = (accum_t)(int16_t)(accum >> 16);
+#else
+  int32_t sum_x = 0;
+  int32_t sum_y = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    struct input_event *event = &events[i];
+    int32_t             is_x  = is_motion(event) && event->code == INPUT_REL_X;
+    int32_t             is_y  = is_motion(event) && event->code == INPUT_REL_Y;
+
+    sum_x += event->value & -is_x;
+    sum_y += event->value & -is_y;
+    moved += is_x | is_y;
+    off_axis += (is_x | is_y) & (event->code != locked_code);
+    event->value &= -(int32_t)(!(is_x | is_y) || event->code == locked_code);
+  }
+
+  data->accum_x = (accum_t)(data->accum_x + sum_x);
+  data->accum_y = (accum_t)(data->accum_y + sum_y);
+#endif
+
+  AC_STATS_INCN(data, events, moved);
+  AC_STATS_INCN(data, suppressed_off_axis, off_axis);
+
+  *motion = moved;
+  return true;
+}
+
+int zmk_axis_constrain_handle_events(const struct device *dev, struct input_event *events,
+                                     size_t count, int16_t *remainder) {
+  const struct axis_constrain_config *config     = dev->config;
+  struct axis_constrain_data         *data       = dev->data;
+  struct event_log                    divergence = {0};
+  size_t                              motion     = 0;
+  bool                                handled    = false;
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t entry_cycles = k_cycle_get_32();
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+  bool calibrating = false;
+#endif
+
+  if (events == NULL && count > 0) {
+    return -EINVAL;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t locked_cycles = k_cycle_get_32();
+#endif
+
+  /* One parameter set for the whole batch, like a single event */
+  const struct zmk_axis_constrain_params *params = atomic_ptr_get(&data->params);
+
+  if (params->sticky && data->locked_axis != AXIS_NONE && !calibrating_locked(data)) {
+    handled = constrain_locked_burst_locked(data, events, count,
+                                            effective_threshold_locked(data, params), &motion,
+                                            &divergence);
+  }
+
+  for (size_t i = 0; i < count && !handled; i++) {
+    struct input_event *event = &events[i];
+
+    if (!is_motion(event)) {
+      continue;
+    }
+
+    bool             is_x = (event->code == INPUT_REL_X);
+    struct event_log log  = {.is_x = is_x};
+
+    AC_STATS_INC(data, events);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+    if (data->calib.active) {
+      calibration_record_locked(&data->calib, is_x, event->value);
+      calibrating = true;
+      continue;
+    }
+#endif
+
+    constrain_event_locked(data, config, params, event, is_x, &log);
+    motion++;
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+    if (log.diverged) {
+      divergence = log;
+    }
+#endif
+  }
+
+  if (motion > 0 && params->sticky) {
+    k_work_reschedule(&data->release_work, K_MSEC(params->release_after_ms));
+  }
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+  if (calibrating) {
+    k_work_reschedule(&data->calib.stroke_work,
+                      K_MSEC(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION_STROKE_GAP_MS));
+  }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  uint32_t unlocking_cycles = k_cycle_get_32();
+#endif
+
+  k_spin_unlock(&data->lock, key);
+
+  /* The remainder belongs to the caller, so this needs no lock */
+  if (config->scale) {
+    for (size_t i = 0; i < count; i++) {
+      if (is_motion(&events[i])) {
+        events[i].value = scale_value(config, events[i].value, remainder);
+      }
+    }
+  }
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+  if (count > 0) {
+    profile_record(data, &data->profile.handle_events[burst_bucket(count)], count, entry_cycles,
+                   locked_cycles, unlocking_cycles);
+  }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+  emit_divergence_log(&divergence);
+#endif
+
+  return 0;
+}
+
+static int validate_params(const struct axis_constrain_config     *config,
+                           const struct zmk_axis_constrain_params *params) {
+  if (params->threshold <= 0 || params->threshold > MAX_ACCUM) {
+    return -EINVAL;
+  }
+  /* Same bound as the devicetree check; larger deltas would overflow the Q8 estimator */
+  if (config->auto_threshold && params->threshold > config->auto_threshold_max) {
+    return -EINVAL;
+  }
+  if (params->release_after_ms < 0 || (params->sticky && params->release_after_ms == 0)) {
+    return -EINVAL;
+  }
+  return 0;
+}
+
+int zmk_axis_constrain_get_params(const struct device              *dev,
+                                  struct zmk_axis_constrain_params *params) {
+  struct axis_constrain_data *data = dev->data;
+
+  k_mutex_lock(&axis_constrain_params_mutex, K_FOREVER);
+  *params = *(const struct zmk_axis_constrain_params *)atomic_ptr_get(&data->params);
+  k_mutex_unlock(&axis_constrain_params_mutex);
+
+  return 0;
+}
+
+static int publish_params(const struct device                    *dev,
+                          const struct zmk_axis_constrain_params *params) {
+  const struct axis_constrain_config *config = dev->config;
+  struct axis_constrain_data         *data   = dev->data;
+
+  int ret = validate_params(config, params);
+  if (ret < 0) {
+    return ret;
+  }
+
+  k_mutex_lock(&axis_constrain_params_mutex, K_FOREVER);
+
+  struct zmk_axis_constrain_params *active = atomic_ptr_get(&data->params);
+  struct zmk_axis_constrain_params *next =
+      (active == &data->params_buf[0]) ? &data->params_buf[1] : &data->params_buf[0];
+
+  *next = *params;
+  atomic_ptr_set(&data->params, next);
+
+  /*
+   * Readers only hold the pointer inside the lock; once we have taken it no
+   * reader can still see the old buffer, so the next writer may reuse it.
+   */
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  /*
+   * A stroke started in one mode must not continue in the other: sticky mode
+   * lets the accumulators grow past the lock, which would skew non-sticky
+   * classification, and a lock taken in sticky mode would outlive it.
+   */
+  if (next->sticky != active->sticky) {
+    reset_state_locked(data);
+  }
+  /* A release still pending from sticky mode would clear a non-sticky stroke when it fires */
+  if (active->sticky && !next->sticky) {
+    k_work_cancel_delayable(&data->release_work);
+  }
+  k_spin_unlock(&data->lock, key);
+
+  k_mutex_unlock(&axis_constrain_params_mutex);
+
+  LOG_DBG("Parameters updated (threshold=%d, sticky=%s, release_after_ms=%d)", params->threshold,
+          params->sticky ? "true" : "false", params->release_after_ms);
+
+  return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS)
+static void save_work_handler(struct k_work *work) {
+  struct k_work_delayable    *dwork = k_work_delayable_from_work(work);
+  struct axis_constrain_data *data  = CONTAINER_OF(dwork, struct axis_constrain_data, save_work);
+  struct zmk_axis_constrain_params params;
+  char                             path[SETTINGS_PATH_MAX];
+
+  zmk_axis_constrain_get_params(data->dev, &params);
+
+  for (size_t i = 0; i < ARRAY_SIZE(settings_fields); i++) {
+    int len = snprintf(path, sizeof(path), "axis_constrain/%s/%s", data->dev->name,
+                       settings_fields[i].name);
+
+    /* A truncated name would be saved but never matched on load */
+    if (len < 0 || (size_t)len >= sizeof(path)) {
+      LOG_ERR("Settings name for %s/%s is too long, not saved", data->dev->name,
+              settings_fields[i].name);
+      continue;
+    }
+
+    int ret = settings_save_one(path, (const uint8_t *)&params + settings_fields[i].offset,
+                                settings_fields[i].size);
+    if (ret < 0) {
+      LOG_ERR("Failed to save %s (%d)", path, ret);
+    }
+  }
+}
+
+/* Publish the parameters axis_constrain_settings_set() staged for dev, if any */
+static void publish_loaded_params(const struct device *dev) {
+  struct axis_constrain_data *data = dev->data;
+
+  if (!data->loaded_pending) {
+    return;
+  }
+  data->loaded_pending = false;
+
+  if (publish_params(dev, &data->loaded) < 0) {
+    LOG_WRN("Ignoring invalid saved parameters for %s", dev->name);
+    return;
+  }
+
+  LOG_DBG("Loaded threshold=%d, sticky=%s, release_after_ms=%d for %s", data->loaded.threshold,
+          data->loaded.sticky ? "true" : "false", data->loaded.release_after_ms, dev->name);
+}
+#endif
+
+int zmk_axis_constrain_set_params(const struct device                    *dev,
+                                  const struct zmk_axis_constrain_params *params) {
+  int ret = publish_params(dev, params);
+  if (ret < 0) {
+    return ret;
+  }
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS)
+  struct axis_constrain_data *data = dev->data;
+
+  /* Coalesce bursts of tuning into one flash write, off the input thread */
+  k_work_reschedule(&data->save_work, K_MSEC(CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE));
+#endif
+
+  return 0;
+}
+
+#define AC_PARAM_ACCESSORS(field, type)                                              \
+  type zmk_axis_constrain_get_##field(const struct device *dev) {                    \
+    struct zmk_axis_constrain_params params;                                         \
+                                                                                     \
+    zmk_axis_constrain_get_params(dev, &params);                                     \
+    return params.field;                                                             \
+  }                                                                                  \
+                                                                                     \
+  int zmk_axis_constrain_set_##field(const struct device *dev, type value) {         \
+    struct zmk_axis_constrain_params params;                                         \
+                                                                                     \
+    /* k_mutex is recursive, so the read-modify-write is atomic for writers */       \
+    k_mutex_lock(&axis_constrain_params_mutex, K_FOREVER);                           \
+    zmk_axis_constrain_get_params(dev, &params);                                     \
+    params.field = value;                                                            \
+    int ret      = zmk_axis_constrain_set_params(dev, &params);                      \
+    k_mutex_unlock(&axis_constrain_params_mutex);                                    \
+                                                                                     \
+    return ret;                                                                      \
+  }
+
+AC_PARAM_ACCESSORS(threshold, int)
+AC_PARAM_ACCESSORS(sticky, bool)
+AC_PARAM_ACCESSORS(release_after_ms, int)
+
+int zmk_axis_constrain_get_state(const struct device *dev, struct zmk_axis_constrain_state *state) {
+  struct axis_constrain_data *data = dev->data;
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  const struct zmk_axis_constrain_params *params = atomic_ptr_get(&data->params);
+
+  state->locked_axis         = (enum zmk_axis_constrain_axis)data->locked_axis;
+  state->accum_x             = data->accum_x;
+  state->accum_y             = data->accum_y;
+  state->effective_threshold = effective_threshold_locked(data, params);
+  state->noise_threshold     = data->noise.threshold;
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+  state->calibrating = data->calib.active;
+#else
+  state->calibrating = false;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW)
+  state->shadow_divergences = data->shadow_divergences;
+#else
+  state->shadow_divergences = 0;
+#endif
+
+  k_spin_unlock(&data->lock, key);
+
+  return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_LATENCY_HISTOGRAM)
+int zmk_axis_constrain_get_latency_hist(const struct device                    *dev,
+                                        struct zmk_axis_constrain_latency_hist *hist, bool reset) {
+  struct axis_constrain_data *data = dev->data;
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  *hist = data->latency;
+  if (reset) {
+    memset(&data->latency, 0, sizeof(data->latency));
+  }
+
+  k_spin_unlock(&data->lock, key);
+
+  return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_PROFILING)
+int zmk_axis_constrain_get_profile(const struct device               *dev,
+                                   struct zmk_axis_constrain_profile *profile, bool reset) {
+  struct axis_constrain_data *data = dev->data;
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  *profile = data->profile;
+  if (reset) {
+    memset(&data->profile, 0, sizeof(data->profile));
+  }
+
+  k_spin_unlock(&data->lock, key);
+
+  return 0;
+}
+#endif
+
+static struct zmk_input_processor_driver_api axis_constrain_api = {
+    .handle_event = axis_constrain_handle_event,
+};
+
+static int axis_constrain_init(const struct device *dev) {
+  struct axis_constrain_data         *data   = dev->data;
+  const struct axis_constrain_config *config = dev->config;
+
+  data->dev = dev;
+  reset_state_locked(data);
+  k_work_init_delayable(&data->release_work, release_work_handler);
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_STATS)
+  int err = stats_init_and_reg(&data->stats.s_hdr, STATS_SIZE_32,
+                               (sizeof(data->stats) - sizeof(struct stats_hdr)) / STATS_SIZE_32,
+                               STATS_NAME_INIT_PARMS(axis_constrain), dev->name);
+  if (err < 0) {
+    LOG_WRN("Failed to register statistics for %s (%d)", dev->name, err);
+  }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+  k_work_init_delayable(&data->calib.stroke_work, calibration_stroke_work_handler);
+  k_work_init_delayable(&data->calib.timeout_work, calibration_timeout_work_handler);
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS)
+  k_work_init_delayable(&data->save_work, save_work_handler);
+
+  /*
+   * Apply saved parameters before the first event can arrive. The init
+   * priority is above the flash driver's so the settings backend is usable.
+   */
+  char     subtree[SETTINGS_PATH_MAX];
+  uint32_t start = k_cycle_get_32();
+
+  int len = snprintf(subtree, sizeof(subtree), "axis_constrain/%s", dev->name);
+  int ret = settings_subsys_init();
+
+  if (ret == 0 && (len < 0 || (size_t)len >= sizeof(subtree))) {
+    ret = -ENAMETOOLONG;
+  }
+  if (ret == 0) {
+    ret = settings_load_subtree(subtree);
+  }
+  if (ret < 0) {
+    LOG_ERR("Failed to load settings for %s (%d)", dev->name, ret);
+  }
+  /*
+   * The commit handler only runs for loads of the whole "axis_constrain"
+   * tree, so publish what the load of this instance's subtree staged.
+   */
+  publish_loaded_params(dev);
+
+  uint32_t elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+  if (elapsed_us > CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS_LOAD_BUDGET_US) {
+    LOG_WRN("Loading settings for %s took %u us (budget %u us)", dev->name, elapsed_us,
+            CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS_LOAD_BUDGET_US);
+  } else {
+    LOG_DBG("Loaded settings for %s in %u us", dev->name, elapsed_us);
+  }
+#endif
+
+  LOG_DBG("Initialized (threshold=%d, sticky=%s, release_after_ms=%d, auto_threshold=%s, "
+          "scale=%d/%d)",
+          config->threshold, config->sticky ? "true" : "false", config->release_after_ms,
+          config->auto_threshold ? "true" : "false", config->scale_multiplier,
+          config->scale_divisor);
+
+  return 0;
+}
+
+#define AC_INST(n)                                                                        \
+  BUILD_ASSERT(DT_INST_PROP(n, threshold) > 0, "threshold must be greater than 0");       \
+  BUILD_ASSERT(DT_INST_PROP(n, threshold) <= MAX_ACCUM,                                   \
+               "threshold must fit the accumulators");                                    \
+  BUILD_ASSERT(!DT_INST_PROP(n, sticky) || DT_INST_PROP(n, release_after_ms) > 0,         \
+               "release_after_ms must be > 0 when sticky mode is enabled");               \
+  BUILD_ASSERT(!DT_INST_PROP(n, auto_threshold) || DT_INST_PROP(n, auto_threshold_k) > 0, \
+               "auto_threshold_k must be > 0 when auto threshold is enabled");            \
+  BUILD_ASSERT(!DT_INST_PROP(n, auto_threshold) ||                                        \
+                   (DT_INST_PROP(n, auto_threshold_max) >= DT_INST_PROP(n, threshold) &&  \
+                    DT_INST_PROP(n, auto_threshold_max) <= AUTO_THRESHOLD_LIMIT),         \
+               "auto_threshold_max must be between threshold and 64");                    \
+  BUILD_ASSERT(IN_RANGE(DT_INST_PROP_OR(n, scale_multiplier, 1), 1, INT16_MAX) &&         \
+                   IN_RANGE(DT_INST_PROP_OR(n, scale_divisor, 1), 1, INT16_MAX),          \
+               "scale_multiplier and scale_divisor must be between 1 and 32767");         \
+                                                                                          \
+  /* Valid before init: an input device may report before this one */                     \
+  static struct axis_constrain_data axis_constrain_data_##n = {                           \
+      .lock       = {},                                                                   \
+      .params_buf = {{                                                                    \
+          .threshold        = DT_INST_PROP(n, threshold),                                 \
+          .sticky           = DT_INST_PROP(n, sticky),                                    \
+          .release_after_ms = DT_INST_PROP(n, release_after_ms),                          \
+      }},                                                                                 \
+      .params     = ATOMIC_PTR_INIT(&axis_constrain_data_##n.params_buf[0]),              \
+  };                                                                                      \
+                                                                                          \
+  static const struct axis_constrain_config axis_constrain_config_##n = {                 \
+      .threshold          = DT_INST_PROP(n, threshold),                                   \
+      .sticky             = DT_INST_PROP(n, sticky),                                      \
+      .release_after_ms   = DT_INST_PROP(n, release_after_ms),                            \
+      .auto_threshold     = DT_INST_PROP(n, auto_threshold),                              \
+      .auto_threshold_k   = DT_INST_PROP(n, auto_threshold_k),                            \
+      .auto_threshold_max = DT_INST_PROP(n, auto_threshold_max),                          \
+      .scale              = DT_INST_NODE_HAS_PROP(n, scale_multiplier) ||                 \
+                            DT_INST_NODE_HAS_PROP(n, scale_divisor),                      \
+      .scale_multiplier   = DT_INST_PROP_OR(n, scale_multiplier, 1),                      \
+      .scale_divisor      = DT_INST_PROP_OR(n, scale_divisor, 1),                         \
+  };                                                                                      \
+                                                                                          \
+  DEVICE_DT_INST_DEFINE(n, axis_constrain_init, NULL, &axis_constrain_data_##n,           \
+                        &axis_constrain_config_##n, POST_KERNEL,                          \
+                        CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_INIT_PRIORITY,          \
+                        &axis_constrain_api);
+
+DT_INST_FOREACH_STATUS_OKAY(AC_INST)
+
+#define AC_DEVICE_REF(n) DEVICE_DT_INST_GET(n),
+
+static const struct device *const axis_constrain_devices[] = {
+    DT_INST_FOREACH_STATUS_OKAY(AC_DEVICE_REF)};
+
+const struct device *zmk_axis_constrain_get_device(size_t index) {
+  if (index >= ARRAY_SIZE(axis_constrain_devices)) {
+    return NULL;
+  }
+  return axis_constrain_devices[index];
+}
+
+size_t zmk_axis_constrain_get_instance_size(void) { return sizeof(struct axis_constrain_data); }
+
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS)
+static int axis_constrain_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                                       void *cb_arg) {
+  const char *next;
+
+  for (size_t i = 0; i < ARRAY_SIZE(axis_constrain_devices); i++) {
+    const struct device        *dev  = axis_constrain_devices[i];
+    struct axis_constrain_data *data = dev->data;
+
+    if (!settings_name_steq(name, dev->name, &next) || next == NULL) {
+      continue;
+    }
+
+    for (size_t f = 0; f < ARRAY_SIZE(settings_fields); f++) {
+      if (strcmp(next, settings_fields[f].name) != 0) {
+        continue;
+      }
+      if (len != settings_fields[f].size) {
+        return -EINVAL;
+      }
+
+      /* Fields arrive one by one; validate them together on commit */
+      if (!data->loaded_pending) {
+        zmk_axis_constrain_get_params(dev, &data->loaded);
+        data->loaded_pending = true;
+      }
+
+      int ret = read_cb(cb_arg, (uint8_t *)&data->loaded + settings_fields[f].offset, len);
+      return ret < 0 ? ret : 0;
+    }
+
+    return -ENOENT;
+  }
+
+  return -ENOENT;
+}
+
+static int axis_constrain_settings_commit(void) {
+  for (size_t i = 0; i < ARRAY_SIZE(axis_constrain_devices); i++) {
+    publish_loaded_params(axis_constrain_devices[i]);
+  }
+
+  return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(axis_constrain, "axis_constrain", NULL, axis_constrain_settings_set,
+                               axis_constrain_settings_commit, NULL);
+#endif /* CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SETTINGS */
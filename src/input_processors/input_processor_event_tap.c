@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define DT_DRV_COMPAT zmk_input_processor_event_tap
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <drivers/input_processor.h>
+
+#include <zmk/axis_constrain_trace.h>
+
+LOG_MODULE_DECLARE(axis_constrain, CONFIG_ZMK_LOG_LEVEL);
+
+/*
+ * Each event is packed into one 32-bit record:
+ *   bit 31      axis, 0 = REL_X, 1 = REL_Y
+ *   bits 30..16 milliseconds since the previous record, saturated
+ *   bits 15..0  value as int16_t, saturated
+ */
+#define TAP_AXIS_Y    BIT(31)
+#define TAP_DT_SHIFT  16
+#define TAP_DT_MAX    0x7FFF
+#define TAP_VALUE_MAX INT16_MAX
+
+struct event_tap_config {
+  uint32_t *records;
+  size_t    capacity;
+};
+
+struct event_tap_data {
+  struct k_spinlock lock;
+  size_t            head;
+  size_t            count;
+  uint32_t          overwritten;
+  uint32_t          last_ms;
+};
+
+static inline uint32_t tap_pack(bool is_y, uint32_t dt_ms, int32_t value) {
+  uint32_t dt = MIN(dt_ms, TAP_DT_MAX);
+  int16_t  v  = (int16_t)CLAMP(value, -TAP_VALUE_MAX, TAP_VALUE_MAX);
+
+  return (is_y ? TAP_AXIS_Y : 0) | (dt << TAP_DT_SHIFT) | (uint16_t)v;
+}
+
+static int event_tap_handle_event(const struct device *dev, struct input_event *event,
+                                  uint32_t param1, uint32_t param2,
+                                  struct zmk_input_processor_state *state) {
+  const struct event_tap_config *config = dev->config;
+  struct event_tap_data         *data   = dev->data;
+
+  if (event->type != INPUT_EV_REL) {
+    return 0;
+  }
+
+  if (event->code != INPUT_REL_X && event->code != INPUT_REL_Y) {
+    return 0;
+  }
+
+  uint32_t now = k_uptime_get_32();
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  uint32_t dt = (data->count == 0) ? 0 : now - data->last_ms;
+
+  config->records[data->head] = tap_pack(event->code == INPUT_REL_Y, dt, event->value);
+  data->head                  = (data->head + 1) % config->capacity;
+  data->last_ms               = now;
+  if (data->count < config->capacity) {
+    data->count++;
+  } else {
+    data->overwritten++;
+  }
+
+  k_spin_unlock(&data->lock, key);
+
+  return 0;
+}
+
+static struct zmk_input_processor_driver_api event_tap_api = {
+    .handle_event = event_tap_handle_event,
+};
+
+#define TAP_INST(n)                                                                  \
+  BUILD_ASSERT(DT_INST_PROP(n, capacity) > 0, "capacity must be greater than 0");    \
+                                                                                     \
+  static uint32_t event_tap_records_##n[DT_INST_PROP(n, capacity)];                  \
+                                                                                     \
+  static struct event_tap_data event_tap_data_##n;                                   \
+                                                                                     \
+  static const struct event_tap_config event_tap_config_##n = {                      \
+      .records  = event_tap_records_##n,                                             \
+      .capacity = DT_INST_PROP(n, capacity),                                         \
+  };                                                                                 \
+                                                                                     \
+  DEVICE_DT_INST_DEFINE(n, NULL, NULL, &event_tap_data_##n, &event_tap_config_##n,   \
+                        POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &event_tap_api);
+
+DT_INST_FOREACH_STATUS_OKAY(TAP_INST)
+
+#if IS_ENABLED(CONFIG_SHELL)
+#define TAP_DEVICE_REF(n) DEVICE_DT_INST_GET(n),
+
+static const struct device *const event_tap_devices[] = {
+    DT_INST_FOREACH_STATUS_OKAY(TAP_DEVICE_REF)};
+
+#define TAP_DUMP_BYTES_PER_LINE 32
+
+static const struct device *find_tap(const struct shell *sh, const char *name) {
+  for (size_t i = 0; i < ARRAY_SIZE(event_tap_devices); i++) {
+    if (strcmp(event_tap_devices[i]->name, name) == 0) {
+      return event_tap_devices[i];
+    }
+  }
+
+  shell_error(sh, "No event tap named %s", name);
+  return NULL;
+}
+
+static int cmd_status(const struct shell *sh, size_t argc, char **argv) {
+  for (size_t i = 0; i < ARRAY_SIZE(event_tap_devices); i++) {
+    const struct device           *dev    = event_tap_devices[i];
+    const struct event_tap_config *config = dev->config;
+    struct event_tap_data         *data   = dev->data;
+
+    k_spinlock_key_t key         = k_spin_lock(&data->lock);
+    size_t           count       = data->count;
+    uint32_t         overwritten = data->overwritten;
+    k_spin_unlock(&data->lock, key);
+
+    shell_print(sh, "%s: %zu/%zu records, %u overwritten", dev->name, count, config->capacity,
+                overwritten);
+  }
+
+  return 0;
+}
+
+/* Feed encoded bytes to the shell as hex lines of TAP_DUMP_BYTES_PER_LINE */
+struct dump_line {
+  char   hex[TAP_DUMP_BYTES_PER_LINE * 2 + 1];
+  size_t len;
+};
+
+static void dump_bytes(const struct shell *sh, struct dump_line *line, const uint8_t *bytes,
+                       size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    snprintf(&line->hex[line->len], 3, "%02x", bytes[i]);
+    line->len += 2;
+    if (line->len == sizeof(line->hex) - 1) {
+      shell_print(sh, "%s", line->hex);
+      line->len = 0;
+    }
+  }
+}
+
+/*
+ * Records are exported oldest first in the trace format of
+ * <zmk/axis_constrain_trace.h>, as hex. The ring is read without stopping the
+ * recorder, one record per critical section.
+ */
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev = find_tap(sh, argv[1]);
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  const struct event_tap_config *config = dev->config;
+  struct event_tap_data         *data   = dev->data;
+
+  k_spinlock_key_t key   = k_spin_lock(&data->lock);
+  size_t           count = data->count;
+  size_t           start = (data->head + config->capacity - count) % config->capacity;
+  k_spin_unlock(&data->lock, key);
+
+  struct dump_line line = {.len = 0};
+  uint8_t          buf[ZMK_AXIS_CONSTRAIN_TRACE_RECORD_MAX];
+
+  shell_print(sh, "# %s %zu events", dev->name, count);
+  dump_bytes(sh, &line, buf, zmk_axis_constrain_trace_header(buf));
+
+  for (size_t i = 0; i < count; i++) {
+    key             = k_spin_lock(&data->lock);
+    uint32_t record = config->records[(start + i) % config->capacity];
+    k_spin_unlock(&data->lock, key);
+
+    /* The first delta refers to an event that is no longer recorded */
+    uint32_t dt  = (i == 0) ? 0 : (record >> TAP_DT_SHIFT) & TAP_DT_MAX;
+    size_t   len = zmk_axis_constrain_trace_record(buf, dt, (record & TAP_AXIS_Y) != 0,
+                                                   (int16_t)(record & 0xFFFF));
+
+    dump_bytes(sh, &line, buf, len);
+  }
+
+  if (line.len > 0) {
+    shell_print(sh, "%s", line.hex);
+  }
+
+  return 0;
+}
+
+static int cmd_clear(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev = find_tap(sh, argv[1]);
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  struct event_tap_data *data = dev->data;
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  data->head           = 0;
+  data->count          = 0;
+  data->overwritten    = 0;
+  k_spin_unlock(&data->lock, key);
+
+  return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_event_tap,
+                               SHELL_CMD_ARG(status, NULL, "Show fill level of every tap",
+                                             cmd_status, 1, 0),
+                               SHELL_CMD_ARG(dump, NULL, "Export recorded events: dump <device>",
+                                             cmd_dump, 2, 0),
+                               SHELL_CMD_ARG(clear, NULL, "Discard recorded events: clear <device>",
+                                             cmd_clear, 2, 0),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(event_tap, &sub_event_tap, "Input event recorder", NULL);
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <ac_stream.h>
+#include <drivers/input_processor.h>
+#include <zmk/axis_constrain.h>
+
+#define AC_NODE(label) DT_NODELABEL(label)
+#define AC_DEV(label)  DEVICE_DT_GET(AC_NODE(label))
+
+#define RELEASE_AFTER_MS DT_PROP(AC_NODE(ac_release), release_after_ms)
+#define THRESHOLD        DT_PROP(AC_NODE(ac_clamp), threshold)
+
+#define BATCH_EVENTS     1024
+#define BATCH_MAX        16
+#define BURST_EVENTS     1024
+#define BENCHMARK_EVENTS 4096
+
+/* Pass one REL_X/REL_Y event through dev as an input listener would; 0 if suppressed */
+static int32_t move(const struct device *dev, bool is_x, int32_t value, int16_t *remainder) {
+  struct input_event event = {
+      .type  = INPUT_EV_REL,
+      .code  = is_x ? INPUT_REL_X : INPUT_REL_Y,
+      .value = value,
+  };
+  struct zmk_input_processor_state state = {.remainder = remainder};
+
+  int ret = zmk_input_processor_handle_event(dev, &event, 0, 0, &state);
+
+  return (ret == ZMK_INPUT_PROC_STOP) ? 0 : event.value;
+}
+
+static struct zmk_axis_constrain_state state_of(const struct device *dev) {
+  struct zmk_axis_constrain_state state;
+
+  zassert_ok(zmk_axis_constrain_get_state(dev, &state));
+  return state;
+}
+
+static void *axis_constrain_setup(void) {
+  const struct device *devs[] = {
+      AC_DEV(ac_release),     AC_DEV(ac_clamp),     AC_DEV(ac_isolation_a), AC_DEV(ac_isolation_b),
+      AC_DEV(ac_batch_a),     AC_DEV(ac_batch_b),   AC_DEV(ac_burst_a),     AC_DEV(ac_burst_b),
+      AC_DEV(ac_mode_change), AC_DEV(ac_benchmark),
+  };
+
+  for (size_t i = 0; i < ARRAY_SIZE(devs); i++) {
+    zassert_true(device_is_ready(devs[i]), "%s not ready", devs[i]->name);
+  }
+  return NULL;
+}
+
+ZTEST_SUITE(axis_constrain, NULL, axis_constrain_setup, NULL, NULL, NULL);
+
+/*
+ * The release work runs on the system workqueue release-after-ms after the
+ * last motion event. The margins cover the tick granularity.
+ */
+ZTEST(axis_constrain, test_sticky_release_timing) {
+  const struct device *dev = AC_DEV(ac_release);
+
+  zassert_equal(move(dev, true, 10, NULL), 10);
+  zassert_equal(state_of(dev).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_X);
+  zassert_equal(move(dev, false, 20, NULL), 0, "off-axis motion passed while locked");
+
+  /* Every event, suppressed ones included, postpones the release */
+  k_sleep(K_MSEC(RELEASE_AFTER_MS / 2));
+  zassert_equal(move(dev, false, 20, NULL), 0);
+  k_sleep(K_MSEC(RELEASE_AFTER_MS - 20));
+  zassert_equal(state_of(dev).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_X, "released early");
+
+  k_sleep(K_MSEC(40));
+  zassert_equal(state_of(dev).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_NONE, "not released");
+  zassert_equal(state_of(dev).accum_x, 0);
+  zassert_equal(state_of(dev).accum_y, 0);
+
+  zassert_equal(move(dev, false, 20, NULL), 20);
+  zassert_equal(state_of(dev).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_Y);
+}
+
+/*
+ * The dominant axis accumulator is clamped to the threshold and the other
+ * one cleared, so that a change of direction needs only a threshold's worth
+ * of motion after any amount of travel.
+ */
+ZTEST(axis_constrain, test_non_sticky_clamping) {
+  const struct device *dev = AC_DEV(ac_clamp);
+
+  for (int i = 0; i < 10; i++) {
+    zassert_equal(move(dev, true, 2 * THRESHOLD, NULL), 2 * THRESHOLD);
+    zassert_equal(state_of(dev).accum_x, THRESHOLD);
+    zassert_equal(state_of(dev).accum_y, 0);
+  }
+
+  zassert_equal(move(dev, false, THRESHOLD - 1, NULL), 0);
+  zassert_equal(state_of(dev).accum_y, THRESHOLD - 1);
+
+  zassert_equal(move(dev, false, 2, NULL), 2);
+  zassert_equal(state_of(dev).accum_x, 0);
+  zassert_equal(state_of(dev).accum_y, THRESHOLD);
+
+  zassert_equal(move(dev, true, -(THRESHOLD - 1), NULL), 0);
+  zassert_equal(move(dev, true, -2 * THRESHOLD, NULL), -2 * THRESHOLD);
+  zassert_equal(state_of(dev).accum_x, -THRESHOLD);
+  zassert_equal(state_of(dev).accum_y, 0);
+}
+
+ZTEST(axis_constrain, test_instance_isolation) {
+  const struct device *a = AC_DEV(ac_isolation_a);
+  const struct device *b = AC_DEV(ac_isolation_b);
+
+  zassert_equal(move(a, true, 10, NULL), 10);
+  zassert_equal(state_of(a).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_X);
+  zassert_equal(state_of(b).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_NONE);
+  zassert_equal(state_of(b).accum_x, 0);
+
+  zassert_equal(move(b, false, 10, NULL), 10);
+  zassert_equal(state_of(b).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_Y);
+  zassert_equal(state_of(a).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_X);
+  zassert_equal(move(a, false, 10, NULL), 0);
+
+  /* Runtime parameters and the mode change reset stay per instance */
+  zassert_ok(zmk_axis_constrain_set_threshold(b, 20));
+  zassert_ok(zmk_axis_constrain_set_sticky(b, false));
+  zassert_equal(zmk_axis_constrain_get_threshold(a), DT_PROP(AC_NODE(ac_isolation_a), threshold));
+  zassert_true(zmk_axis_constrain_get_sticky(a));
+  zassert_equal(state_of(a).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_X);
+  zassert_equal(state_of(b).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_NONE);
+}
+
+/*
+ * Turning sticky mode off cancels the pending release, which would otherwise
+ * clear the accumulators of the first non-sticky stroke when it fires.
+ */
+ZTEST(axis_constrain, test_mode_change_cancels_release) {
+  const struct device *dev       = AC_DEV(ac_mode_change);
+  const int            threshold = DT_PROP(AC_NODE(ac_mode_change), threshold);
+
+  zassert_equal(move(dev, true, 10, NULL), 10);
+  zassert_equal(state_of(dev).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_X);
+
+  zassert_ok(zmk_axis_constrain_set_sticky(dev, false));
+  zassert_equal(move(dev, true, threshold - 2, NULL), 0);
+
+  k_sleep(K_MSEC(2 * DT_PROP(AC_NODE(ac_mode_change), release_after_ms)));
+  zassert_equal(state_of(dev).accum_x, threshold - 2, "stale release cleared the stroke");
+}
+
+/*
+ * zmk_axis_constrain_handle_events() must produce the same output, state and
+ * scale remainder as the same events passed one at a time, in both modes.
+ */
+ZTEST(axis_constrain, test_batch_matches_per_event) {
+  const struct device *single = AC_DEV(ac_batch_a);
+  const struct device *batch  = AC_DEV(ac_batch_b);
+  uint32_t             random = 0x9e3779b9;
+
+  for (int pass = 0; pass < 2; pass++) {
+    int16_t single_remainder = 0;
+    int16_t batch_remainder  = 0;
+
+    if (pass == 1) {
+      zassert_ok(zmk_axis_constrain_set_sticky(single, false));
+      zassert_ok(zmk_axis_constrain_set_sticky(batch, false));
+    }
+
+    for (size_t done = 0; done < BATCH_EVENTS;) {
+      struct input_event events[BATCH_MAX];
+      int32_t            expected[BATCH_MAX];
+      size_t             count =
+          MIN(1 + ac_stream_next_random(&random) % BATCH_MAX, BATCH_EVENTS - done);
+
+      for (size_t i = 0; i < count; i++) {
+        uint32_t bits = ac_stream_next_random(&random);
+
+        events[i] = (struct input_event){
+            .type  = INPUT_EV_REL,
+            .code  = (bits & 1) ? INPUT_REL_X : INPUT_REL_Y,
+            .value = (int32_t)((bits >> 1) % 17) - 8,
+        };
+        expected[i] = move(single, events[i].code == INPUT_REL_X, events[i].value,
+                           &single_remainder);
+      }
+
+      zassert_ok(zmk_axis_constrain_handle_events(batch, events, count, &batch_remainder));
+      for (size_t i = 0; i < count; i++) {
+        zassert_equal(events[i].value, expected[i], "event %zu: %d, expected %d", done + i,
+                      events[i].value, expected[i]);
+      }
+      done += count;
+    }
+
+    struct zmk_axis_constrain_state single_state = state_of(single);
+    struct zmk_axis_constrain_state batch_state  = state_of(batch);
+
+    zassert_equal(batch_state.locked_axis, single_state.locked_axis);
+    zassert_equal(batch_state.accum_x, single_state.accum_x);
+    zassert_equal(batch_state.accum_y, single_state.accum_y);
+    zassert_equal(batch_remainder, single_remainder);
+  }
+}
+
+/*
+ * Bursts while an axis is locked take the branchless kernel, SADD16 on
+ * Cortex-M4 with 16-bit accumulators, until the accumulators near MAX_ACCUM
+ * and the headroom guard falls back to the per-event path. The drift of the
+ * deltas takes the accumulators there; output and state must match single
+ * events on both sides of the guard.
+ */
+ZTEST(axis_constrain, test_locked_burst_matches_per_event) {
+  const struct device *single = AC_DEV(ac_burst_a);
+  const struct device *burst  = AC_DEV(ac_burst_b);
+  uint32_t             random = 0x85ebca6b;
+
+  zassert_equal(move(single, true, 10, NULL), 10);
+  zassert_equal(move(burst, true, 10, NULL), 10);
+  zassert_equal(state_of(burst).locked_axis, ZMK_AXIS_CONSTRAIN_AXIS_X);
+
+  for (size_t done = 0; done < BURST_EVENTS; done += BATCH_MAX) {
+    struct input_event events[BATCH_MAX];
+    int32_t            expected[BATCH_MAX];
+
+    for (size_t i = 0; i < BATCH_MAX; i++) {
+      uint32_t bits = ac_stream_next_random(&random);
+
+      events[i] = (struct input_event){
+          .type  = INPUT_EV_REL,
+          .code  = (bits & 1) ? INPUT_REL_X : INPUT_REL_Y,
+          .value = (int32_t)((bits >> 1) % 1024) - 256,
+      };
+      expected[i] = move(single, events[i].code == INPUT_REL_X, events[i].value, NULL);
+    }
+
+    zassert_ok(zmk_axis_constrain_handle_events(burst, events, BATCH_MAX, NULL));
+    for (size_t i = 0; i < BATCH_MAX; i++) {
+      zassert_equal(events[i].value, expected[i], "event %zu: %d, expected %d", done + i,
+                    events[i].value, expected[i]);
+    }
+
+    struct zmk_axis_constrain_state single_state = state_of(single);
+    struct zmk_axis_constrain_state burst_state  = state_of(burst);
+
+    zassert_equal(burst_state.locked_axis, single_state.locked_axis);
+    zassert_equal(burst_state.accum_x, single_state.accum_x, "after event %zu", done);
+    zassert_equal(burst_state.accum_y, single_state.accum_y, "after event %zu", done);
+  }
+}
+
+/*
+ * Cycles per event of the per-event path and the size of the instance state,
+ * for comparing builds on the Cortex-M emulators
+ */
+ZTEST(axis_constrain, test_benchmark) {
+  const struct device *dev    = AC_DEV(ac_benchmark);
+  uint32_t             random = 0x2545f491;
+
+  uint32_t start = k_cycle_get_32();
+
+  for (int i = 0; i < BENCHMARK_EVENTS; i++) {
+    uint32_t bits = ac_stream_next_random(&random);
+
+    move(dev, bits & 1, (int32_t)((bits >> 1) % 17) - 8, NULL);
+  }
+
+  uint32_t cycles = k_cycle_get_32() - start;
+
+  TC_PRINT("%u cycles/event over %d events (%u cycles/s)\n", cycles / BENCHMARK_EVENTS,
+           BENCHMARK_EVENTS, sys_clock_hw_cycles_per_sec());
+  TC_PRINT("%zu bytes of state per instance, %s accumulators\n",
+           zmk_axis_constrain_get_instance_size(),
+           IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_ACCUM_16BIT) ? "16-bit" : "32-bit");
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Persistence on the NVS backend: parameters set at runtime are saved by the
+ * debounced save work, and an instance initialized over saved values starts
+ * with them, before any event and without a global settings_load().
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/ztest.h>
+
+#include <zmk/axis_constrain.h>
+
+static const char *const fields[] = {"threshold", "sticky", "release_after_ms"};
+
+struct saved_field {
+  uint8_t value[sizeof(int)];
+  ssize_t len;
+};
+
+/* Collect the raw values under axis_constrain/<dev>, in the order of fields */
+static int collect(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+                   void *param) {
+  struct saved_field *saved = param;
+
+  for (size_t i = 0; i < ARRAY_SIZE(fields); i++) {
+    if (strcmp(key, fields[i]) == 0) {
+      saved[i].len = read_cb(cb_arg, saved[i].value, MIN(len, sizeof(saved[i].value)));
+      return 0;
+    }
+  }
+  return 0;
+}
+
+static void *settings_setup(void) {
+  zassert_true(device_is_ready(DEVICE_DT_GET(DT_NODELABEL(ac_settings_saved))));
+  zassert_false(device_is_ready(DEVICE_DT_GET(DT_NODELABEL(ac_settings_restored))),
+                "restored instance initialized before the test");
+  return NULL;
+}
+
+ZTEST_SUITE(axis_constrain_settings, NULL, settings_setup, NULL, NULL, NULL);
+
+ZTEST(axis_constrain_settings, test_saved_params_restored_in_init) {
+  const struct device *saved    = DEVICE_DT_GET(DT_NODELABEL(ac_settings_saved));
+  const struct device *restored = DEVICE_DT_GET(DT_NODELABEL(ac_settings_restored));
+
+  const struct zmk_axis_constrain_params params = {
+      .threshold        = 12,
+      .sticky           = false,
+      .release_after_ms = 250,
+  };
+  struct zmk_axis_constrain_params active;
+  struct saved_field               values[ARRAY_SIZE(fields)] = {0};
+  char                             path[SETTINGS_MAX_NAME_LEN];
+
+  zassert_ok(zmk_axis_constrain_set_params(saved, &params));
+  k_sleep(K_MSEC(CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE + 100));
+
+  snprintf(path, sizeof(path), "axis_constrain/%s", saved->name);
+  zassert_ok(settings_load_subtree_direct(path, collect, values));
+  for (size_t i = 0; i < ARRAY_SIZE(fields); i++) {
+    zassert_true(values[i].len > 0, "%s not saved", fields[i]);
+  }
+
+  /* The same values under the other instance, as if saved on a previous boot */
+  for (size_t i = 0; i < ARRAY_SIZE(fields); i++) {
+    snprintf(path, sizeof(path), "axis_constrain/%s/%s", restored->name, fields[i]);
+    zassert_ok(settings_save_one(path, values[i].value, values[i].len));
+  }
+
+  zassert_ok(device_init(restored));
+  zassert_ok(zmk_axis_constrain_get_params(restored, &active));
+  zassert_equal(active.threshold, params.threshold);
+  zassert_equal(active.sticky, params.sticky);
+  zassert_equal(active.release_after_ms, params.release_after_ms);
+}
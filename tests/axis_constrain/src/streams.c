@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Differential test against the shadow reference model on real kernel
+ * primitives: a recorded trace and a pseudo-random stream are played in real
+ * time through instances in either mode, and the first event whose output
+ * differs from the reference fails the test.
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <ac_stream.h>
+#include <drivers/input_processor.h>
+#include <zmk/axis_constrain.h>
+
+/* Streams are played in chunks, so that the suite fits the RAM of qemu_cortex_m0 */
+#define CHUNK_EVENTS    64
+#define RANDOM_EVENTS   1024
+#define RANDOM_PAUSE_MS 300
+
+static const uint8_t strokes_trace[] = {
+#include "strokes.trace.inc"
+};
+
+static const struct device *const stream_devs[] = {
+    DEVICE_DT_GET(DT_NODELABEL(ac_stream_sticky)),
+    DEVICE_DT_GET(DT_NODELABEL(ac_stream_non_sticky)),
+    DEVICE_DT_GET(DT_NODELABEL(ac_stream_auto)),
+};
+
+static struct ac_stream_event events[CHUNK_EVENTS];
+static int16_t                remainders[ARRAY_SIZE(stream_devs)];
+
+static void *streams_setup(void) {
+  for (size_t i = 0; i < ARRAY_SIZE(stream_devs); i++) {
+    zassert_true(device_is_ready(stream_devs[i]), "%s not ready", stream_devs[i]->name);
+  }
+  return NULL;
+}
+
+/* Let pending releases run, so that every stream starts from a released state */
+static void streams_before(void *fixture) {
+  memset(remainders, 0, sizeof(remainders));
+  k_sleep(K_SECONDS(1));
+}
+
+/* Without the reference model there is nothing to compare against */
+static bool streams_predicate(const void *global_state) {
+  return IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_SHADOW);
+}
+
+ZTEST_SUITE(axis_constrain_streams, streams_predicate, streams_setup, streams_before, NULL, NULL);
+
+/*
+ * Play events through every instance at once, so that the stream runs in real
+ * time only once; first is the index of events[0] in the whole stream
+ */
+static void play(const char *stream, size_t first, const struct ac_stream_event *stream_events,
+                 size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (stream_events[i].dt_ms > 0) {
+      k_sleep(K_MSEC(stream_events[i].dt_ms));
+    }
+
+    for (size_t d = 0; d < ARRAY_SIZE(stream_devs); d++) {
+      struct input_event event = {
+          .type  = INPUT_EV_REL,
+          .code  = stream_events[i].is_x ? INPUT_REL_X : INPUT_REL_Y,
+          .value = stream_events[i].value,
+      };
+      struct zmk_input_processor_state state = {.remainder = &remainders[d]};
+      struct zmk_axis_constrain_state  ac_state;
+
+      zmk_input_processor_handle_event(stream_devs[d], &event, 0, 0, &state);
+
+      zassert_ok(zmk_axis_constrain_get_state(stream_devs[d], &ac_state));
+      zassert_equal(ac_state.shadow_divergences, 0, "%s, %s: event %zu (%s %d -> %d) diverged",
+                    stream, stream_devs[d]->name, first + i, stream_events[i].is_x ? "X" : "Y",
+                    stream_events[i].value, event.value);
+    }
+  }
+}
+
+ZTEST(axis_constrain_streams, test_recorded_stream) {
+  size_t pos    = ZMK_AXIS_CONSTRAIN_TRACE_HEADER_SIZE;
+  size_t played = 0;
+
+  zassert_ok(ac_stream_check_header(strokes_trace, sizeof(strokes_trace)), "bad trace header");
+
+  while (pos < sizeof(strokes_trace)) {
+    size_t count = 0;
+
+    while (count < ARRAY_SIZE(events) && pos < sizeof(strokes_trace)) {
+      zassert_ok(ac_stream_decode_event(strokes_trace, sizeof(strokes_trace), &pos,
+                                        &events[count]),
+                 "bad trace record at byte %zu", pos);
+      count++;
+    }
+    play("strokes.trace", played, events, count);
+    played += count;
+  }
+}
+
+/* Each chunk is a stream of its own seed, as the generator cannot resume */
+ZTEST(axis_constrain_streams, test_random_stream) {
+  for (size_t played = 0; played < RANDOM_EVENTS; played += ARRAY_SIZE(events)) {
+    ac_stream_random(0x5eed + played, RANDOM_PAUSE_MS, events, ARRAY_SIZE(events));
+    play("random stream", played, events, ARRAY_SIZE(events));
+  }
+}
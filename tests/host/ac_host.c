@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Instances of the real processor for the host. The source is included so
+ * that instances can be created from runtime values the way AC_INST()
+ * creates them from devicetree.
+ */
+
+#include "input_processor_axis_constrain.c"
+
+#include <ac_host.h>
+
+struct ac_host {
+  struct device                dev;
+  struct axis_constrain_config config;
+  struct axis_constrain_data   data;
+  /* The listener's remainder, for track-remainders */
+  int16_t                      remainder;
+  uint32_t                    *releases;
+  size_t                       release_count;
+  size_t                       release_capacity;
+  struct ac_host              *next;
+};
+
+static struct ac_host *hosts;
+
+/* The BUILD_ASSERTs of AC_INST() */
+static bool valid_devicetree(const struct ac_host_params *params) {
+  if (params->threshold <= 0 || params->threshold > MAX_ACCUM) {
+    return false;
+  }
+  if (params->sticky && params->release_after_ms <= 0) {
+    return false;
+  }
+  if (params->auto_threshold &&
+      (params->auto_threshold_k <= 0 || params->auto_threshold_max < params->threshold ||
+       params->auto_threshold_max > AUTO_THRESHOLD_LIMIT)) {
+    return false;
+  }
+  return IN_RANGE(params->scale_multiplier, 1, INT16_MAX) &&
+         IN_RANGE(params->scale_divisor, 1, INT16_MAX);
+}
+
+int ac_host_create(const struct ac_host_params *params, struct ac_host **host) {
+  if (!valid_devicetree(params) || params->release_after_ms < 0) {
+    return -EINVAL;
+  }
+
+  struct ac_host *new = calloc(1, sizeof(*new));
+  if (new == NULL) {
+    return -ENOMEM;
+  }
+
+  new->config = (struct axis_constrain_config){
+      .threshold          = params->threshold,
+      .sticky             = params->sticky,
+      .release_after_ms   = params->release_after_ms,
+      .auto_threshold     = params->auto_threshold,
+      .auto_threshold_k   = params->auto_threshold_k,
+      .auto_threshold_max = params->auto_threshold_max,
+      .scale              = params->scale_multiplier != 1 || params->scale_divisor != 1,
+      .scale_multiplier   = params->scale_multiplier,
+      .scale_divisor      = params->scale_divisor,
+  };
+  new->data.params_buf[0] = (struct zmk_axis_constrain_params){
+      .threshold        = params->threshold,
+      .sticky           = params->sticky,
+      .release_after_ms = params->release_after_ms,
+  };
+  new->data.params = &new->data.params_buf[0];
+  new->dev         = (struct device){
+      .name   = "ac_host",
+      .config = &new->config,
+      .api    = &axis_constrain_api,
+      .data   = &new->data,
+  };
+
+  int ret = axis_constrain_init(&new->dev);
+  if (ret < 0) {
+    ac_host_works_remove(new, sizeof(*new));
+    free(new);
+    return ret;
+  }
+
+  new->next = hosts;
+  hosts     = new;
+  *host     = new;
+
+  return 0;
+}
+
+void ac_host_destroy(struct ac_host *host) {
+  for (struct ac_host **it = &hosts; *it != NULL; it = &(*it)->next) {
+    if (*it == host) {
+      *it = host->next;
+      break;
+    }
+  }
+
+  ac_host_works_remove(host, sizeof(*host));
+  free(host->releases);
+  free(host);
+}
+
+const struct device *ac_host_device(struct ac_host *host) { return &host->dev; }
+
+int32_t ac_host_event(struct ac_host *host, bool is_x, int32_t value) {
+  struct input_event event = {
+      .type  = INPUT_EV_REL,
+      .code  = is_x ? INPUT_REL_X : INPUT_REL_Y,
+      .value = value,
+  };
+  struct zmk_input_processor_state state = {.remainder = &host->remainder};
+
+  int ret = zmk_input_processor_handle_event(&host->dev, &event, 0, 0, &state);
+
+  return (ret == ZMK_INPUT_PROC_STOP) ? 0 : event.value;
+}
+
+static void record_release(struct ac_host *host) {
+  if (host->release_count == host->release_capacity) {
+    size_t    capacity = MAX(host->release_capacity * 2, 64);
+    uint32_t *releases = realloc(host->releases, capacity * sizeof(*releases));
+
+    if (releases == NULL) {
+      return;
+    }
+    host->releases         = releases;
+    host->release_capacity = capacity;
+  }
+  host->releases[host->release_count++] = ac_host_now_ms();
+}
+
+void ac_host_work_ran(struct k_work_delayable *dwork) {
+  for (struct ac_host *host = hosts; host != NULL; host = host->next) {
+    if (dwork == &host->data.release_work) {
+      record_release(host);
+      return;
+    }
+  }
+}
+
+size_t ac_host_releases(const struct ac_host *host, uint32_t *times_ms, size_t max) {
+  size_t count = MIN(max, host->release_count);
+
+  if (count > 0) {
+    memcpy(times_ms, host->releases, count * sizeof(*times_ms));
+  }
+  return host->release_count;
+}
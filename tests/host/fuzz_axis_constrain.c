@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * libFuzzer target over the host build. The input selects the devicetree
+ * properties of one instance, then a sequence of operations: single and
+ * batched events with arbitrary values, time advances, runtime parameter
+ * changes, calibration and events the processor must leave alone.
+ *
+ * Failures are the event path invariants asserted under CONFIG_ASSERT, a
+ * divergence from the shadow reference model, sanitizer reports, and the
+ * API contract checks below.
+ */
+
+#include <zephyr/kernel.h>
+
+#include <ac_host.h>
+#include <drivers/input_processor.h>
+#include <zmk/axis_constrain.h>
+
+#define FUZZ_CHECK(cond)                                                                           \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      fprintf(stderr, "%s:%d: check \"%s\" failed\n", __FILE__, __LINE__, #cond);                 \
+      abort();                                                                                     \
+    }                                                                                              \
+  } while (0)
+
+#define BATCH_MAX 16
+
+struct input {
+  const uint8_t *data;
+  size_t         size;
+};
+
+/* Past the end of the input every read is 0 */
+static uint8_t take_u8(struct input *in) {
+  if (in->size == 0) {
+    return 0;
+  }
+  in->size--;
+  return *in->data++;
+}
+
+static uint16_t take_u16(struct input *in) { return take_u8(in) | (uint16_t)take_u8(in) << 8; }
+
+static uint32_t take_u32(struct input *in) { return take_u16(in) | (uint32_t)take_u16(in) << 16; }
+
+/*
+ * Sensor jitter for the noise estimate, sensor sized deltas, and sometimes
+ * any int32_t to reach the saturation paths
+ */
+static int32_t take_value(struct input *in) {
+  switch (take_u8(in) & 0x3) {
+    case 0:
+      return (int32_t)take_u32(in);
+    case 1:
+      return (int16_t)take_u16(in);
+    case 2:
+      return (int8_t)take_u8(in);
+    default:
+      return (int8_t)take_u8(in) % 3;
+  }
+}
+
+static struct input_event take_event(struct input *in) {
+  static const uint16_t codes[] = {INPUT_REL_X, INPUT_REL_Y, INPUT_REL_WHEEL};
+  uint8_t               kind    = take_u8(in);
+
+  return (struct input_event){
+      .type  = (kind & 0x80) ? INPUT_EV_KEY : INPUT_EV_REL,
+      .code  = codes[(kind & 0x7f) % ARRAY_SIZE(codes)],
+      .sync  = (kind & 0x40) != 0,
+      .value = take_value(in),
+  };
+}
+
+static bool is_motion(const struct input_event *event) {
+  return event->type == INPUT_EV_REL &&
+         (event->code == INPUT_REL_X || event->code == INPUT_REL_Y);
+}
+
+static bool same_event(const struct input_event *a, const struct input_event *b) {
+  return a->sync == b->sync && a->type == b->type && a->code == b->code && a->value == b->value;
+}
+
+static bool same_params(const struct zmk_axis_constrain_params *a,
+                        const struct zmk_axis_constrain_params *b) {
+  return a->threshold == b->threshold && a->sticky == b->sticky &&
+         a->release_after_ms == b->release_after_ms;
+}
+
+static struct ac_host_params take_params(struct input *in) {
+  uint8_t               flags  = take_u8(in);
+  struct ac_host_params params = {
+      .threshold        = 1 + take_u8(in),
+      .sticky           = (flags & BIT(0)) != 0,
+      .release_after_ms = take_u8(in),
+      .auto_threshold   = (flags & BIT(1)) != 0,
+      .scale_multiplier = 1,
+      .scale_divisor    = 1,
+  };
+
+  /* Keep threshold within auto-threshold-max, or the instance is rejected */
+  if (params.auto_threshold) {
+    params.threshold          = 1 + params.threshold % 64;
+    params.auto_threshold_k   = 1 + take_u8(in) % 8;
+    params.auto_threshold_max = params.threshold + take_u8(in) % (65 - params.threshold);
+  }
+  if (flags & BIT(2)) {
+    params.scale_multiplier = 1 + take_u8(in);
+    params.scale_divisor    = 1 + take_u8(in);
+  }
+  return params;
+}
+
+static void check_state(const struct device *dev) {
+  struct zmk_axis_constrain_state state;
+
+  FUZZ_CHECK(zmk_axis_constrain_get_state(dev, &state) == 0);
+  FUZZ_CHECK(state.shadow_divergences == 0);
+}
+
+static void set_params(const struct device *dev, struct input *in) {
+  struct zmk_axis_constrain_params before;
+  struct zmk_axis_constrain_params after;
+  struct zmk_axis_constrain_params params = {
+      .threshold        = (take_u8(in) & 0x80) ? take_value(in) : 1 + take_u8(in),
+      .sticky           = take_u8(in) & 1,
+      .release_after_ms = (int8_t)take_u8(in),
+  };
+
+  zmk_axis_constrain_get_params(dev, &before);
+  int ret = zmk_axis_constrain_set_params(dev, &params);
+  zmk_axis_constrain_get_params(dev, &after);
+
+  /* Rejected parameters leave the active ones in place */
+  FUZZ_CHECK(ret == 0 || ret == -EINVAL);
+  FUZZ_CHECK(same_params((ret == 0) ? &params : &before, &after));
+}
+
+static void pass_through(const struct device *dev, struct input *in) {
+  struct input_event event = take_event(in);
+
+  if (is_motion(&event)) {
+    event.type = INPUT_EV_KEY;
+  }
+
+  struct input_event               original  = event;
+  int16_t                          remainder = 0;
+  struct zmk_input_processor_state state     = {.remainder = &remainder};
+
+  FUZZ_CHECK(zmk_input_processor_handle_event(dev, &event, 0, 0, &state) ==
+             ZMK_INPUT_PROC_CONTINUE);
+  FUZZ_CHECK(same_event(&event, &original));
+}
+
+static void batch(const struct device *dev, struct input *in, int16_t *remainder) {
+  struct input_event events[BATCH_MAX];
+  struct input_event original[BATCH_MAX];
+  size_t             count = 1 + take_u8(in) % BATCH_MAX;
+
+  for (size_t i = 0; i < count; i++) {
+    events[i] = original[i] = take_event(in);
+  }
+
+  FUZZ_CHECK(zmk_axis_constrain_handle_events(dev, events, count, remainder) == 0);
+
+  for (size_t i = 0; i < count; i++) {
+    if (!is_motion(&original[i])) {
+      FUZZ_CHECK(same_event(&events[i], &original[i]));
+    }
+  }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  struct input          in        = {data, size};
+  struct ac_host_params params    = take_params(&in);
+  struct ac_host       *host;
+  int16_t               remainder = 0;
+
+  ac_host_run_pending();
+  ac_host_clock_reset();
+
+  if (ac_host_create(&params, &host) < 0) {
+    return 0;
+  }
+
+  const struct device *dev = ac_host_device(host);
+
+  while (in.size > 0) {
+    switch (take_u8(&in) % 8) {
+      case 0:
+        ac_host_event(host, true, take_value(&in));
+        break;
+      case 1:
+        ac_host_event(host, false, take_value(&in));
+        break;
+      case 2:
+        ac_host_advance_to(ac_host_now_ms() + take_u16(&in) % 1024);
+        break;
+      case 3:
+        batch(dev, &in, (take_u8(&in) & 1) ? &remainder : NULL);
+        break;
+      case 4:
+        set_params(dev, &in);
+        break;
+      case 5:
+#if IS_ENABLED(CONFIG_ZMK_INPUT_PROCESSOR_AXIS_CONSTRAIN_CALIBRATION)
+        if (take_u8(&in) & 1) {
+          int ret = zmk_axis_constrain_calibrate_start(dev);
+
+          FUZZ_CHECK(ret == 0 || ret == -EBUSY);
+          FUZZ_CHECK(zmk_axis_constrain_is_calibrating(dev));
+        } else {
+          zmk_axis_constrain_calibrate_cancel(dev);
+          FUZZ_CHECK(!zmk_axis_constrain_is_calibrating(dev));
+        }
+#endif
+        break;
+      case 6:
+        pass_through(dev, &in);
+        break;
+      case 7:
+        ac_host_run_pending();
+        break;
+    }
+    check_state(dev);
+  }
+
+  ac_host_run_pending();
+  check_state(dev);
+  ac_host_destroy(host);
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the fuzz target without libFuzzer: on the files given as arguments,
+ * e.g. a crash to reproduce, or else on pseudo-random inputs from a fixed
+ * seed, as a smoke test for compilers without -fsanitize=fuzzer.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ac_stream.h>
+
+#define RANDOM_INPUTS   2000
+#define RANDOM_SIZE_MAX 1024
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static int run_file(const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    perror(path);
+    return 1;
+  }
+
+  uint8_t *data = NULL;
+  size_t   size = 0;
+  uint8_t  chunk[4096];
+  size_t   read;
+
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    uint8_t *grown = realloc(data, size + read);
+    if (grown == NULL) {
+      free(data);
+      fclose(file);
+      return 1;
+    }
+    data = grown;
+    for (size_t i = 0; i < read; i++) {
+      data[size++] = chunk[i];
+    }
+  }
+  fclose(file);
+
+  LLVMFuzzerTestOneInput(data, size);
+  free(data);
+
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      if (run_file(argv[i]) != 0) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  static uint8_t data[RANDOM_SIZE_MAX];
+  uint32_t       state = 0x2545f491;
+
+  for (int i = 0; i < RANDOM_INPUTS; i++) {
+    size_t size = ac_stream_next_random(&state) % RANDOM_SIZE_MAX;
+
+    for (size_t j = 0; j < size; j++) {
+      data[j] = (uint8_t)ac_stream_next_random(&state);
+    }
+    LLVMFuzzerTestOneInput(data, size);
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * Host build of the axis constrain processor: the real handler from
+ * src/input_processors/ on stub kernel primitives, for the replay tools,
+ * tests and fuzzing. scripts/axis_constrain/host.py loads it with ctypes.
+ *
+ * Time is virtual. It only moves when advanced, and delayable work such as
+ * the sticky release runs inside ac_host_advance_to(), in deadline order,
+ * with the clock set to its deadline. Work is due once the clock reaches the
+ * deadline, so an event arriving exactly release-after-ms after the previous
+ * one sees the release first.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/** Devicetree properties of an instance; the first three are also runtime parameters */
+struct ac_host_params {
+  int32_t threshold;
+  bool    sticky;
+  int32_t release_after_ms;
+  bool    auto_threshold;
+  int32_t auto_threshold_k;
+  int32_t auto_threshold_max;
+  int32_t scale_multiplier;
+  int32_t scale_divisor;
+};
+
+struct ac_host;
+
+/**
+ * Create and initialize an instance, like a devicetree node with params.
+ * The remainder of the fused scale is tracked, as with track-remainders.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the devicetree build would reject params
+ * @retval -ENOMEM if out of memory
+ */
+int ac_host_create(const struct ac_host_params *params, struct ac_host **host);
+
+/** Destroy an instance, cancelling its pending work. */
+void ac_host_destroy(struct ac_host *host);
+
+/** The instance as a device, for the <zmk/axis_constrain.h> API. */
+const struct device *ac_host_device(struct ac_host *host);
+
+/**
+ * Pass one REL_X/REL_Y event through the processor at the current time, as
+ * an input listener would.
+ *
+ * @return the value the listener passes on, 0 if suppressed or stopped
+ */
+int32_t ac_host_event(struct ac_host *host, bool is_x, int32_t value);
+
+/**
+ * Copy the times at which the release work of host ran, oldest first.
+ *
+ * @return the number of runs, which may exceed max
+ */
+size_t ac_host_releases(const struct ac_host *host, uint32_t *times_ms, size_t max);
+
+/** Current virtual time. */
+uint32_t ac_host_now_ms(void);
+
+/** Move time forward to t_ms, running work as it comes due. t_ms must not be in the past. */
+void ac_host_advance_to(uint32_t t_ms);
+
+/** Advance until no work is pending, e.g. after the last event. */
+void ac_host_run_pending(void);
+
+/** Set the time back to 0. Only valid while no work is pending. */
+void ac_host_clock_reset(void);
+
+/* Between kernel.c and ac_host.c: report a work item that ran, drop those of a dead owner */
+void ac_host_work_ran(struct k_work_delayable *dwork);
+void ac_host_works_remove(const void *owner, size_t size);
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * Host builds have no devicetree: instances are created at runtime by
+ * ac_host_create(), so the devicetree instance list is empty.
+ */
+
+#include <zephyr/kernel.h>
+
+struct device {
+  const char *name;
+  const void *config;
+  const void *api;
+  void       *data;
+};
+
+#define DT_INST_FOREACH_STATUS_OKAY(fn)
+
+static inline bool device_is_ready(const struct device *dev) { return dev != NULL; }
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <zephyr/device.h>
+
+#define INPUT_EV_KEY 0x01
+#define INPUT_EV_REL 0x02
+#define INPUT_EV_ABS 0x03
+
+#define INPUT_REL_X     0x00
+#define INPUT_REL_Y     0x01
+#define INPUT_REL_WHEEL 0x08
+
+struct input_event {
+  const struct device *dev;
+  uint8_t              sync;
+  uint8_t              type;
+  uint16_t             code;
+  int32_t              value;
+};
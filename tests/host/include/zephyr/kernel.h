@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * The subset of the Zephyr kernel API the processor uses, for host builds.
+ * Everything runs on one thread: spinlocks and mutexes do nothing, and time
+ * is the virtual clock of kernel.c, see <ac_host.h>.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BIT(n)                         ((uint32_t)1 << (n))
+#define MIN(a, b)                      (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)                      (((a) > (b)) ? (a) : (b))
+#define CLAMP(val, low, high)          (((val) <= (low)) ? (low) : MIN(val, high))
+#define IN_RANGE(val, min, max)        ((val) >= (min) && (val) <= (max))
+#define ARRAY_SIZE(array)              (sizeof(array) / sizeof((array)[0]))
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define BUILD_ASSERT(expr, msg)        _Static_assert(expr, msg)
+#define ALWAYS_INLINE                  inline __attribute__((always_inline))
+
+/* IS_ENABLED() as in <zephyr/sys/util_macro.h>: 1 if the macro is defined to 1 */
+#define _XXXX1                              _YYYY,
+#define IS_ENABLED(config_macro)            _IS_ENABLED1(config_macro)
+#define _IS_ENABLED1(config_macro)          _IS_ENABLED2(_XXXX##config_macro)
+#define _IS_ENABLED2(one_or_two_args)       _IS_ENABLED3(one_or_two_args 1, 0)
+#define _IS_ENABLED3(ignore_this, val, ...) val
+
+#if defined(CONFIG_ASSERT)
+#define __ASSERT(test, fmt, ...)                                                                   \
+  do {                                                                                             \
+    if (!(test)) {                                                                                 \
+      fprintf(stderr, "%s:%d: assertion \"%s\" failed: " fmt "\n", __FILE__, __LINE__, #test,      \
+              ##__VA_ARGS__);                                                                      \
+      abort();                                                                                     \
+    }                                                                                              \
+  } while (0)
+#else
+#define __ASSERT(test, fmt, ...) ((void)sizeof(test))
+#endif
+#define __ASSERT_NO_MSG(test) __ASSERT(test, "")
+
+typedef struct {
+  int64_t ms;
+} k_timeout_t;
+
+#define K_MSEC(ms) ((k_timeout_t){(ms)})
+#define K_NO_WAIT  K_MSEC(0)
+#define K_FOREVER  K_MSEC(-1)
+
+struct k_spinlock {
+  char unused;
+};
+typedef int k_spinlock_key_t;
+
+static inline k_spinlock_key_t k_spin_lock(struct k_spinlock *lock) {
+  (void)lock;
+  return 0;
+}
+
+static inline void k_spin_unlock(struct k_spinlock *lock, k_spinlock_key_t key) {
+  (void)lock;
+  (void)key;
+}
+
+struct k_mutex {
+  char unused;
+};
+
+#define K_MUTEX_DEFINE(name) struct k_mutex name
+
+static inline int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout) {
+  (void)mutex;
+  (void)timeout;
+  return 0;
+}
+
+static inline int k_mutex_unlock(struct k_mutex *mutex) {
+  (void)mutex;
+  return 0;
+}
+
+typedef void *atomic_ptr_t;
+
+#define ATOMIC_PTR_INIT(p) (p)
+
+static inline void *atomic_ptr_get(const atomic_ptr_t *target) { return *target; }
+
+static inline void *atomic_ptr_set(atomic_ptr_t *target, void *value) {
+  void *old = *target;
+
+  *target = value;
+  return old;
+}
+
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work {
+  k_work_handler_t handler;
+};
+
+/* Pending work runs once the virtual clock is advanced to its deadline */
+struct k_work_delayable {
+  struct k_work            work;
+  bool                     pending;
+  uint32_t                 deadline_ms;
+  struct k_work_delayable *next;
+};
+
+static inline struct k_work_delayable *k_work_delayable_from_work(struct k_work *work) {
+  return CONTAINER_OF(work, struct k_work_delayable, work);
+}
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler);
+int  k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int  k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int  k_work_cancel_delayable(struct k_work_delayable *dwork);
+
+uint32_t k_uptime_get_32(void);
+int64_t  k_uptime_get(void);
+uint32_t k_cycle_get_32(void);
+uint32_t k_cyc_to_us_floor32(uint32_t cycles);
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * __ramfunc as on Cortex-M, minus long_call: the function stays out of line
+ * in a section of its own, which the host linker places with the other code.
+ */
+#define __ramfunc __attribute__((noinline, section(".ramfunc")))
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/* Warnings and errors go to stderr, the rest is compiled out */
+
+#include <stdio.h>
+
+#define LOG_MODULE_REGISTER(name, level)
+#define LOG_MODULE_DECLARE(name, level)
+
+#define AC_HOST_LOG(level, fmt, ...) fprintf(stderr, level ": " fmt "\n", ##__VA_ARGS__)
+#define AC_HOST_LOG_NONE(fmt, ...)                                                                 \
+  do {                                                                                             \
+    if (0) {                                                                                       \
+      fprintf(stderr, fmt, ##__VA_ARGS__);                                                         \
+    }                                                                                              \
+  } while (0)
+
+#define LOG_ERR(...) AC_HOST_LOG("error", __VA_ARGS__)
+#define LOG_WRN(...) AC_HOST_LOG("warning", __VA_ARGS__)
+#define LOG_INF(...) AC_HOST_LOG_NONE(__VA_ARGS__)
+#define LOG_DBG(...) AC_HOST_LOG_NONE(__VA_ARGS__)
@@ -0,0 +1,8 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/* Included unconditionally; the host configuration does not use it */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Virtual clock and workqueue behind the stub <zephyr/kernel.h>. Delayable
+ * work is kept in a list from k_work_init_delayable() on; advancing the clock
+ * runs the due items in deadline order, so a test decides exactly where a
+ * timeout falls relative to the events around it.
+ */
+
+#include <zephyr/kernel.h>
+
+#include <ac_host.h>
+
+/* Cycles per millisecond of k_cycle_get_32(), i.e. a 64 MHz core */
+#define CYCLES_PER_MS 64000
+
+static uint32_t                 now_ms;
+static struct k_work_delayable *works;
+
+static void unlink_work(struct k_work_delayable *dwork) {
+  for (struct k_work_delayable **it = &works; *it != NULL; it = &(*it)->next) {
+    if (*it == dwork) {
+      *it = dwork->next;
+      return;
+    }
+  }
+}
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler) {
+  /* Re-initializing must not leave the item in the list twice */
+  unlink_work(dwork);
+
+  *dwork = (struct k_work_delayable){
+      .work = {.handler = handler},
+      .next = works,
+  };
+  works = dwork;
+}
+
+int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+  dwork->pending     = true;
+  dwork->deadline_ms = now_ms + (uint32_t)MAX(delay.ms, 0);
+  return 1;
+}
+
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+  if (dwork->pending) {
+    return 0;
+  }
+  return k_work_reschedule(dwork, delay);
+}
+
+int k_work_cancel_delayable(struct k_work_delayable *dwork) {
+  dwork->pending = false;
+  return 0;
+}
+
+/* Work is only removed when its owner goes away, see ac_host_destroy() */
+void ac_host_works_remove(const void *owner, size_t size) {
+  const char *begin = owner;
+
+  for (struct k_work_delayable **it = &works; *it != NULL;) {
+    const char *work = (const char *)*it;
+
+    if (work >= begin && work < begin + size) {
+      *it = (*it)->next;
+    } else {
+      it = &(*it)->next;
+    }
+  }
+}
+
+static struct k_work_delayable *next_due(uint32_t t_ms) {
+  struct k_work_delayable *due = NULL;
+
+  for (struct k_work_delayable *it = works; it != NULL; it = it->next) {
+    if (it->pending && it->deadline_ms <= t_ms &&
+        (due == NULL || it->deadline_ms < due->deadline_ms)) {
+      due = it;
+    }
+  }
+  return due;
+}
+
+void ac_host_advance_to(uint32_t t_ms) {
+  __ASSERT(t_ms >= now_ms, "time cannot go back from %u to %u ms", now_ms, t_ms);
+
+  struct k_work_delayable *due;
+
+  while ((due = next_due(t_ms)) != NULL) {
+    now_ms       = MAX(now_ms, due->deadline_ms);
+    due->pending = false;
+    due->work.handler(&due->work);
+    ac_host_work_ran(due);
+  }
+  now_ms = t_ms;
+}
+
+void ac_host_run_pending(void) {
+  struct k_work_delayable *due;
+
+  while ((due = next_due(UINT32_MAX)) != NULL) {
+    ac_host_advance_to(MAX(now_ms, due->deadline_ms));
+  }
+}
+
+void ac_host_clock_reset(void) {
+  __ASSERT(next_due(UINT32_MAX) == NULL, "work still pending");
+  now_ms = 0;
+}
+
+uint32_t ac_host_now_ms(void) { return now_ms; }
+
+uint32_t k_uptime_get_32(void) { return now_ms; }
+
+int64_t k_uptime_get(void) { return now_ms; }
+
+uint32_t k_cycle_get_32(void) { return now_ms * CYCLES_PER_MS; }
+
+uint32_t k_cyc_to_us_floor32(uint32_t cycles) { return cycles / (CYCLES_PER_MS / 1000); }
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * When the sticky release work runs, on the virtual clock of the host build:
+ * release-after-ms after the last motion event, and never while events keep
+ * arriving sooner than that.
+ */
+
+#include <zephyr/kernel.h>
+
+#include <ac_host.h>
+#include <zmk/axis_constrain.h>
+
+static int failures;
+
+#define CHECK(cond)                                                                                \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      fprintf(stderr, "%s:%d: %s: check \"%s\" failed\n", __FILE__, __LINE__, __func__, #cond);    \
+      failures++;                                                                                  \
+    }                                                                                              \
+  } while (0)
+
+#define RELEASE_AFTER_MS 100
+
+static struct ac_host *create(bool sticky, int32_t release_after_ms) {
+  struct ac_host_params params = {
+      .threshold        = 5,
+      .sticky           = sticky,
+      .release_after_ms = release_after_ms,
+      .scale_multiplier = 1,
+      .scale_divisor    = 1,
+  };
+  struct ac_host *host = NULL;
+
+  ac_host_run_pending();
+  ac_host_clock_reset();
+  if (ac_host_create(&params, &host) < 0) {
+    fprintf(stderr, "cannot create an instance\n");
+    exit(1);
+  }
+  return host;
+}
+
+/* count events of value along one axis, every period_ms from t_ms on; returns the last time */
+static uint32_t stroke(struct ac_host *host, uint32_t t_ms, int count, uint32_t period_ms,
+                       bool is_x, int32_t value) {
+  for (int i = 0; i < count; i++, t_ms += period_ms) {
+    ac_host_advance_to(t_ms);
+    ac_host_event(host, is_x, value);
+  }
+  return t_ms - period_ms;
+}
+
+static enum zmk_axis_constrain_axis locked_axis(struct ac_host *host) {
+  struct zmk_axis_constrain_state state;
+
+  zmk_axis_constrain_get_state(ac_host_device(host), &state);
+  return state.locked_axis;
+}
+
+static void test_release_after_last_event(void) {
+  struct ac_host *host = create(true, RELEASE_AFTER_MS);
+  uint32_t        last = stroke(host, 0, 6, 10, true, 10);
+  uint32_t        time;
+
+  CHECK(locked_axis(host) == ZMK_AXIS_CONSTRAIN_AXIS_X);
+
+  ac_host_advance_to(last + RELEASE_AFTER_MS - 1);
+  CHECK(ac_host_releases(host, NULL, 0) == 0);
+  CHECK(locked_axis(host) == ZMK_AXIS_CONSTRAIN_AXIS_X);
+
+  ac_host_advance_to(last + RELEASE_AFTER_MS + 50);
+  CHECK(ac_host_releases(host, &time, 1) == 1);
+  CHECK(time == last + RELEASE_AFTER_MS);
+  CHECK(locked_axis(host) == ZMK_AXIS_CONSTRAIN_AXIS_NONE);
+
+  ac_host_destroy(host);
+}
+
+static void test_events_postpone_release(void) {
+  struct ac_host *host = create(true, RELEASE_AFTER_MS);
+  uint32_t        last = stroke(host, 0, 20, RELEASE_AFTER_MS - 1, true, 10);
+  uint32_t        time;
+
+  CHECK(ac_host_releases(host, NULL, 0) == 0);
+  CHECK(locked_axis(host) == ZMK_AXIS_CONSTRAIN_AXIS_X);
+
+  ac_host_run_pending();
+  CHECK(ac_host_releases(host, &time, 1) == 1);
+  CHECK(time == last + RELEASE_AFTER_MS);
+
+  ac_host_destroy(host);
+}
+
+/* An event at the deadline sees the lock released and may lock the other axis */
+static void test_event_at_deadline(void) {
+  struct ac_host *host = create(true, RELEASE_AFTER_MS);
+  uint32_t        last = stroke(host, 0, 6, 10, true, 10);
+
+  ac_host_advance_to(last + RELEASE_AFTER_MS - 1);
+  CHECK(ac_host_event(host, false, 20) == 0);
+
+  last = ac_host_now_ms();
+  ac_host_advance_to(last + RELEASE_AFTER_MS);
+  CHECK(ac_host_releases(host, NULL, 0) == 1);
+  CHECK(ac_host_event(host, false, 20) == 20);
+  CHECK(locked_axis(host) == ZMK_AXIS_CONSTRAIN_AXIS_Y);
+
+  ac_host_destroy(host);
+}
+
+/* Suppressed motion before the lock counts as activity as well */
+static void test_prelock_events_postpone_release(void) {
+  struct ac_host *host = create(true, RELEASE_AFTER_MS);
+  uint32_t        last = stroke(host, 0, 4, 60, true, 1);
+
+  CHECK(locked_axis(host) == ZMK_AXIS_CONSTRAIN_AXIS_NONE);
+  ac_host_advance_to(last + RELEASE_AFTER_MS - 1);
+  CHECK(ac_host_releases(host, NULL, 0) == 0);
+  ac_host_run_pending();
+  CHECK(ac_host_releases(host, NULL, 0) == 1);
+
+  ac_host_destroy(host);
+}
+
+static void test_batch_schedules_once(void) {
+  struct ac_host    *host   = create(true, RELEASE_AFTER_MS);
+  struct input_event events[8];
+  uint32_t           time;
+
+  for (size_t i = 0; i < ARRAY_SIZE(events); i++) {
+    events[i] = (struct input_event){
+        .type  = INPUT_EV_REL,
+        .code  = (i % 2 == 0) ? INPUT_REL_X : INPUT_REL_Y,
+        .value = (i % 2 == 0) ? 10 : 1,
+    };
+  }
+
+  ac_host_advance_to(40);
+  CHECK(zmk_axis_constrain_handle_events(ac_host_device(host), events, ARRAY_SIZE(events),
+                                         NULL) == 0);
+  CHECK(locked_axis(host) == ZMK_AXIS_CONSTRAIN_AXIS_X);
+
+  ac_host_run_pending();
+  CHECK(ac_host_releases(host, &time, 1) == 1);
+  CHECK(time == 40 + RELEASE_AFTER_MS);
+
+  ac_host_destroy(host);
+}
+
+/* A new timeout applies from the next event on, not to the pending release */
+static void test_runtime_release_after_ms(void) {
+  struct ac_host *host  = create(true, RELEASE_AFTER_MS);
+  uint32_t        first = stroke(host, 0, 6, 10, true, 10);
+  uint32_t        times[2];
+
+  CHECK(zmk_axis_constrain_set_release_after_ms(ac_host_device(host), 30) == 0);
+  ac_host_advance_to(first + 30);
+  CHECK(ac_host_releases(host, NULL, 0) == 0);
+
+  uint32_t second = stroke(host, first + RELEASE_AFTER_MS, 6, 10, true, 10);
+
+  ac_host_run_pending();
+  CHECK(ac_host_releases(host, times, 2) == 2);
+  CHECK(times[0] == first + RELEASE_AFTER_MS);
+  CHECK(times[1] == second + 30);
+
+  ac_host_destroy(host);
+}
+
+static void test_non_sticky_never_releases(void) {
+  struct ac_host *host = create(false, RELEASE_AFTER_MS);
+
+  stroke(host, 0, 20, 10, true, 10);
+  ac_host_run_pending();
+  CHECK(ac_host_releases(host, NULL, 0) == 0);
+
+  ac_host_destroy(host);
+}
+
+/* A release pending when sticky mode is turned off must not clear the next non-sticky stroke */
+static void test_mode_change_cancels_release(void) {
+  struct ac_host                 *host = create(true, RELEASE_AFTER_MS);
+  struct zmk_axis_constrain_state state;
+  uint32_t                        last = stroke(host, 0, 6, 10, true, 10);
+
+  CHECK(zmk_axis_constrain_set_sticky(ac_host_device(host), false) == 0);
+  stroke(host, last + 10, 1, 10, true, 3);
+  ac_host_run_pending();
+
+  CHECK(ac_host_releases(host, NULL, 0) == 0);
+  zmk_axis_constrain_get_state(ac_host_device(host), &state);
+  CHECK(state.accum_x == 3);
+
+  ac_host_destroy(host);
+}
+
+static void test_instances_release_independently(void) {
+  struct ac_host *fast = create(true, 50);
+  struct ac_host *slow;
+  uint32_t        time;
+
+  struct ac_host_params params = {
+      .threshold        = 5,
+      .sticky           = true,
+      .release_after_ms = 200,
+      .scale_multiplier = 1,
+      .scale_divisor    = 1,
+  };
+  CHECK(ac_host_create(&params, &slow) == 0);
+
+  stroke(slow, 0, 6, 10, false, 10);
+  uint32_t last = stroke(fast, 50, 6, 10, true, 10);
+
+  ac_host_advance_to(last + 50);
+  CHECK(ac_host_releases(fast, &time, 1) == 1);
+  CHECK(time == last + 50);
+  CHECK(ac_host_releases(slow, NULL, 0) == 0);
+  CHECK(locked_axis(slow) == ZMK_AXIS_CONSTRAIN_AXIS_Y);
+
+  ac_host_run_pending();
+  CHECK(ac_host_releases(slow, &time, 1) == 1);
+  CHECK(time == 50 + 200);
+  CHECK(ac_host_releases(fast, NULL, 0) == 1);
+
+  ac_host_destroy(slow);
+  ac_host_destroy(fast);
+}
+
+int main(void) {
+  test_release_after_last_event();
+  test_events_postpone_release();
+  test_event_at_deadline();
+  test_prelock_events_postpone_release();
+  test_batch_schedules_once();
+  test_runtime_release_after_ms();
+  test_non_sticky_never_releases();
+  test_mode_change_cancels_release();
+  test_instances_release_independently();
+
+  if (failures > 0) {
+    fprintf(stderr, "%d checks failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Differential test against the shadow reference model: pseudo-random
+ * streams and the traces given as arguments are played through instances
+ * in either mode, and the first event whose output differs from the
+ * reference fails the test.
+ */
+
+#include <zephyr/kernel.h>
+
+#include <ac_host.h>
+#include <ac_stream.h>
+#include <zmk/axis_constrain.h>
+
+#define RANDOM_STREAMS   64
+#define RANDOM_EVENTS    4096
+#define RANDOM_PAUSE_MS  400
+#define TRACE_EVENTS_MAX (1 << 16)
+
+static const struct {
+  const char           *name;
+  struct ac_host_params params;
+} configs[] = {
+    {"sticky",
+     {.threshold        = 5,
+      .sticky           = true,
+      .release_after_ms = 100,
+      .scale_multiplier = 1,
+      .scale_divisor    = 1}},
+    {"non-sticky",
+     {.threshold        = 8,
+      .scale_multiplier = 1,
+      .scale_divisor    = 1}},
+    {"auto-threshold",
+     {.threshold          = 3,
+      .sticky             = true,
+      .release_after_ms   = 150,
+      .auto_threshold     = true,
+      .auto_threshold_k   = 3,
+      .auto_threshold_max = 40,
+      .scale_multiplier   = 3,
+      .scale_divisor      = 2}},
+};
+
+/* Play events through a fresh instance; false at the first divergence */
+static bool play(const char *stream, const struct ac_stream_event *events, size_t count) {
+  for (size_t c = 0; c < ARRAY_SIZE(configs); c++) {
+    struct ac_host *host;
+
+    ac_host_run_pending();
+    ac_host_clock_reset();
+    if (ac_host_create(&configs[c].params, &host) < 0) {
+      fprintf(stderr, "cannot create a %s instance\n", configs[c].name);
+      return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+      struct zmk_axis_constrain_state state;
+
+      ac_host_advance_to(ac_host_now_ms() + events[i].dt_ms);
+      int32_t output = ac_host_event(host, events[i].is_x, events[i].value);
+
+      zmk_axis_constrain_get_state(ac_host_device(host), &state);
+      if (state.shadow_divergences > 0) {
+        fprintf(stderr, "%s, %s: event %zu at %u ms (%s %d -> %d) diverged\n", stream,
+                configs[c].name, i, ac_host_now_ms(), events[i].is_x ? "X" : "Y",
+                events[i].value, output);
+        ac_host_destroy(host);
+        return false;
+      }
+    }
+
+    ac_host_destroy(host);
+  }
+  return true;
+}
+
+static bool play_trace(const char *path) {
+  static uint8_t                trace[TRACE_EVENTS_MAX * ZMK_AXIS_CONSTRAIN_TRACE_RECORD_MAX];
+  static struct ac_stream_event events[TRACE_EVENTS_MAX];
+
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    perror(path);
+    return false;
+  }
+  size_t size = fread(trace, 1, sizeof(trace), file);
+  fclose(file);
+
+  int count = ac_stream_decode(trace, size, events, ARRAY_SIZE(events));
+  if (count < 0 || count > (int)ARRAY_SIZE(events)) {
+    fprintf(stderr, "%s: not a trace of at most %d events\n", path, TRACE_EVENTS_MAX);
+    return false;
+  }
+  return play(path, events, count);
+}
+
+int main(int argc, char **argv) {
+  static struct ac_stream_event events[RANDOM_EVENTS];
+  bool                          passed = true;
+
+  for (uint32_t seed = 1; seed <= RANDOM_STREAMS && passed; seed++) {
+    char name[32];
+
+    snprintf(name, sizeof(name), "random stream %u", seed);
+    ac_stream_random(seed, RANDOM_PAUSE_MS, events, ARRAY_SIZE(events));
+    passed = play(name, events, ARRAY_SIZE(events));
+  }
+
+  for (int i = 1; i < argc && passed; i++) {
+    passed = play_trace(argv[i]);
+  }
+
+  return passed ? 0 : 1;
+}
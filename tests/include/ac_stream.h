@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * Event streams for differential tests against the shadow reference model:
+ * recorded traces in the format of <zmk/axis_constrain_trace.h>, and
+ * pseudo-random strokes. The tests play them through a processor and fail
+ * at the first event whose output differs from the reference.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zmk/axis_constrain_trace.h>
+
+struct ac_stream_event {
+  /** Milliseconds since the previous event */
+  uint32_t dt_ms;
+  bool     is_x;
+  int32_t  value;
+};
+
+static inline int ac_stream_varint(const uint8_t *trace, size_t size, size_t *pos,
+                                   uint32_t *value) {
+  *value = 0;
+
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (*pos >= size) {
+      return -EINVAL;
+    }
+
+    uint8_t byte = trace[(*pos)++];
+
+    *value |= (uint32_t)(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return 0;
+    }
+  }
+  return -EINVAL;
+}
+
+/** @return 0 if trace starts with a header of the supported version, -EINVAL otherwise */
+static inline int ac_stream_check_header(const uint8_t *trace, size_t size) {
+  if (size < ZMK_AXIS_CONSTRAIN_TRACE_HEADER_SIZE || trace[0] != 'A' || trace[1] != 'C' ||
+      trace[2] != 'T' || trace[3] != 'R' || trace[4] != ZMK_AXIS_CONSTRAIN_TRACE_VERSION) {
+    return -EINVAL;
+  }
+  return 0;
+}
+
+/**
+ * Decode the record at *pos, past the header, and advance *pos to the next
+ * one. Lets a test play a trace in chunks instead of decoding it whole.
+ *
+ * @return 0, or -EINVAL if the record is malformed
+ */
+static inline int ac_stream_decode_event(const uint8_t *trace, size_t size, size_t *pos,
+                                         struct ac_stream_event *event) {
+  uint32_t dt_ms;
+  uint32_t code;
+
+  if (ac_stream_varint(trace, size, pos, &dt_ms) < 0 ||
+      ac_stream_varint(trace, size, pos, &code) < 0) {
+    return -EINVAL;
+  }
+
+  uint32_t zigzag = code >> 1;
+
+  *event = (struct ac_stream_event){
+      .dt_ms = dt_ms,
+      .is_x  = (code & 1) == 0,
+      .value = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1),
+  };
+  return 0;
+}
+
+/**
+ * Decode a binary trace into events.
+ *
+ * @return the number of events, which may exceed max, or -EINVAL if the
+ *         trace is malformed
+ */
+static inline int ac_stream_decode(const uint8_t *trace, size_t size,
+                                   struct ac_stream_event *events, size_t max) {
+  if (ac_stream_check_header(trace, size) < 0) {
+    return -EINVAL;
+  }
+
+  size_t pos   = ZMK_AXIS_CONSTRAIN_TRACE_HEADER_SIZE;
+  int    count = 0;
+
+  while (pos < size) {
+    struct ac_stream_event event;
+
+    if (ac_stream_decode_event(trace, size, &pos, &event) < 0) {
+      return -EINVAL;
+    }
+    if ((size_t)count < max) {
+      events[count] = event;
+    }
+    count++;
+  }
+  return count;
+}
+
+/* xorshift32, also the random source of the other tests and the fuzz smoke run */
+static inline uint32_t ac_stream_next_random(uint32_t *state) {
+  uint32_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+/**
+ * Fill events with pseudo-random strokes from seed: runs of reports a few
+ * milliseconds apart along a random direction, from nearly axis aligned to
+ * diagonal, with jitter, occasional spikes and pauses of up to pause_max_ms
+ * between strokes.
+ */
+static inline void ac_stream_random(uint32_t seed, uint32_t pause_max_ms,
+                                    struct ac_stream_event *events, size_t count) {
+  uint32_t state = (seed != 0) ? seed : 1;
+  size_t   i     = 0;
+
+  while (i < count) {
+    size_t   length     = 4 + ac_stream_next_random(&state) % 60;
+    bool     major_x    = ac_stream_next_random(&state) & 1;
+    int32_t  sign_major = (ac_stream_next_random(&state) & 1) ? 1 : -1;
+    int32_t  sign_minor = (ac_stream_next_random(&state) & 1) ? 1 : -1;
+    /* Minor over major axis speed in eighths, 8 is diagonal */
+    int32_t  slope      = ac_stream_next_random(&state) % 9;
+    uint32_t speed      = 1 + ac_stream_next_random(&state) % 24;
+    uint32_t pause      = (pause_max_ms > 0) ? ac_stream_next_random(&state) % pause_max_ms : 0;
+
+    for (size_t n = 0; n < length && i < count; n++) {
+      uint32_t bits   = ac_stream_next_random(&state);
+      int32_t  major  = 1 + (int32_t)(bits % speed);
+      int32_t  jitter = (int32_t)((bits >> 8) % 3) - 1;
+      int32_t  minor  = (major * slope + (int32_t)((bits >> 12) % 8)) / 8 + jitter;
+
+      /* One report in 256 is a spike of any int16_t value */
+      if (((bits >> 16) & 0xff) == 0) {
+        major = (int16_t)ac_stream_next_random(&state);
+      }
+
+      events[i++] = (struct ac_stream_event){
+          .dt_ms = (n == 0) ? pause : 1 + (bits >> 24) % 8,
+          .is_x  = major_x,
+          .value = sign_major * major,
+      };
+      if (i < count && minor != 0) {
+        events[i++] = (struct ac_stream_event){.is_x = !major_x, .value = sign_minor * minor};
+      }
+    }
+  }
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 matchey
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * The part of ZMK's <drivers/input_processor.h> the processor implements, so
+ * that it can be built and tested without a ZMK application.
+ */
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+
+#define ZMK_INPUT_PROC_CONTINUE 0
+#define ZMK_INPUT_PROC_STOP     1
+
+struct zmk_input_processor_state {
+  uint8_t  input_device_index;
+  int16_t *remainder;
+};
+
+typedef int (*zmk_input_processor_handle_event_callback_t)(
+    const struct device *dev, struct input_event *event, uint32_t param1, uint32_t param2,
+    struct zmk_input_processor_state *state);
+
+struct zmk_input_processor_driver_api {
+  zmk_input_processor_handle_event_callback_t handle_event;
+};
+
+static inline int zmk_input_processor_handle_event(const struct device              *dev,
+                                                   struct input_event               *event,
+                                                   uint32_t                          param1,
+                                                   uint32_t                          param2,
+                                                   struct zmk_input_processor_state *state) {
+  const struct zmk_input_processor_driver_api *api = dev->api;
+
+  return api->handle_event(dev, event, param1, param2, state);
+}